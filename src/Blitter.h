@@ -0,0 +1,177 @@
+#pragma once
+// Blitter.h - Span-based 1-bit sprite blitter writing straight into an RGB565 buffer
+//
+// Source rows are walked a byte at a time; horizontal runs of set bits are
+// emitted as spans and filled with 32-bit pixel-pair writes.  Scaled rows are
+// produced by copying each span down, so pixels between spans stay untouched.
+// Mirroring reads the row's bytes back to front through a bit-reverse table.
+//
+// The destination buffer uses the M5Canvas (LovyanGFX) 16-bit layout, which
+// stores RGB565 byte-swapped; colors are passed in native RGB565.
+
+#include <stdint.h>
+#include <string.h>
+
+// ── Bit-reverse table (for mirror_h) ───────────────────────────────────────
+
+struct BitReverseTable {
+    uint8_t v[256];
+    constexpr BitReverseTable() : v() {
+        for (int i = 0; i < 256; i++) {
+            uint8_t r = 0;
+            for (int b = 0; b < 8; b++) if (i & (1 << b)) r |= (uint8_t)(0x80 >> b);
+            v[i] = r;
+        }
+    }
+};
+static constexpr BitReverseTable BIT_REVERSE{};
+
+// ── Blit target ────────────────────────────────────────────────────────────
+
+struct BlitTarget {
+    uint16_t* buf;     // row-major, byte-swapped RGB565
+    int       width;
+    int       height;
+};
+
+static inline uint16_t swap565(uint16_t c) { return (uint16_t)((c >> 8) | (c << 8)); }
+
+// Fill n pixels with an already-swapped color, two pixels per store
+static inline void fillSpan565(uint16_t* p, int n, uint16_t c) {
+    if (n <= 0) return;
+    if (((uintptr_t)p & 2) != 0) { *p++ = c; n--; }
+    uint32_t  pair = ((uint32_t)c << 16) | c;
+    uint32_t* q    = (uint32_t*)p;
+    for (; n >= 2; n -= 2) *q++ = pair;
+    if (n) *(uint16_t*)q = c;
+}
+
+// ── Span blit ──────────────────────────────────────────────────────────────
+
+// Same contract as Renderer::drawBitmap1bit (MONO_HLSB, MSB first).
+inline void blit1bit(const BlitTarget& t, const uint8_t* data, int srcW, int srcH,
+                     int x, int y, uint16_t fgColor, uint16_t bgColor,
+                     bool transparent, int scale, bool mirror_h) {
+    if (!t.buf || !data || srcW <= 0 || srcH <= 0 || scale < 1) return;
+
+    const int stride = (srcW + 7) / 8;
+    const int pad    = mirror_h ? stride * 8 - srcW : 0;
+    const uint16_t fg = swap565(fgColor);
+    const uint16_t bg = swap565(bgColor);
+
+    // Visible source rows only
+    int row0 = 0, row1 = srcH;
+    if (y < 0)                  row0 = (-y) / scale;
+    if (y + srcH * scale > t.height) row1 = (t.height - y + scale - 1) / scale;
+    if (row0 >= row1) return;
+
+    // Scaled rows of one source row, clipped to the target
+    struct RowSpan {
+        const BlitTarget& t; int x, dy0, dy1, scale, srcW;
+        void fill(int c0, int c1, uint16_t color) const {
+            if (c0 < 0) c0 = 0;
+            if (c1 > srcW) c1 = srcW;
+            int x0 = x + c0 * scale, x1 = x + c1 * scale;
+            if (x0 < 0) x0 = 0;
+            if (x1 > t.width) x1 = t.width;
+            int n = x1 - x0;
+            if (n <= 0) return;
+            uint16_t* first = t.buf + dy0 * t.width + x0;
+            fillSpan565(first, n, color);
+            for (int dy = dy0 + 1; dy < dy1; dy++)
+                memcpy(t.buf + dy * t.width + x0, first, (size_t)n * 2);
+        }
+    };
+
+    for (int row = row0; row < row1; row++) {
+        int dy0 = y + row * scale;
+        int dy1 = dy0 + scale;
+        if (dy0 < 0)        dy0 = 0;
+        if (dy1 > t.height) dy1 = t.height;
+        RowSpan rs{ t, x, dy0, dy1, scale, srcW };
+
+        if (!transparent) rs.fill(0, srcW, bg);
+
+        const uint8_t* src = data + row * stride;
+        int runStart = -1;
+        for (int i = 0; i < stride; i++) {
+            uint8_t b    = mirror_h ? BIT_REVERSE.v[src[stride - 1 - i]] : src[i];
+            int     base = i * 8 - pad;
+            if (b == 0x00) {
+                if (runStart >= 0) { rs.fill(runStart, base, fg); runStart = -1; }
+                continue;
+            }
+            if (b == 0xFF) {
+                if (runStart < 0) runStart = base;
+                continue;
+            }
+            for (int bit = 0; bit < 8; bit++) {
+                bool set = (b & (0x80 >> bit)) != 0;
+                if (set && runStart < 0) runStart = base + bit;
+                else if (!set && runStart >= 0) { rs.fill(runStart, base + bit, fg); runStart = -1; }
+            }
+        }
+        if (runStart >= 0) rs.fill(runStart, srcW, fg);
+    }
+}
+
+// ── Run-masked images ─────────────────────────────────────────────────────
+
+// The opaque pixels of one row of an image, [x0, x1)
+struct PixelRun { uint16_t x0, x1; };
+
+// An image plus, per row, its opaque runs in x order: row r's are
+// runs[rowStart[r]] up to runs[rowStart[r + 1]]
+struct RunImage {
+    const uint16_t* buf;        // row-major, byte-swapped RGB565
+    int             width;
+    int             height;
+    const uint32_t* rowStart;   // height + 1 entries
+    const PixelRun* runs;
+};
+
+// List the runs of pixels not equal to key (byte-swapped) in img; returns
+// how many.  With runs null only counts them.
+inline uint32_t findRuns(const BlitTarget& img, uint16_t key, uint32_t* rowStart, PixelRun* runs) {
+    uint32_t n = 0;
+    for (int row = 0; row < img.height; row++) {
+        const uint16_t* p = img.buf + row * img.width;
+        if (rowStart) rowStart[row] = n;
+        int x = 0;
+        while (x < img.width) {
+            while (x < img.width && p[x] == key) x++;
+            if (x == img.width) break;
+            int x0 = x;
+            while (x < img.width && p[x] != key) x++;
+            if (runs) runs[n] = { (uint16_t)x0, (uint16_t)x };
+            n++;
+        }
+    }
+    if (rowStart) rowStart[img.height] = n;
+    return n;
+}
+
+// Copy the opaque pixels of columns [srcX, srcX + w) of src to (x, y) in t.
+// Clipped to t.
+inline void blitRuns(const BlitTarget& t, const RunImage& src, int srcX, int x, int y, int w) {
+    if (!t.buf || !src.buf) return;
+    if (x < 0)           { srcX -= x; w += x; x = 0; }
+    if (w > t.width - x) w = t.width - x;
+    if (w <= 0) return;
+    int srcEnd = srcX + w;
+    for (int row = y < 0 ? -y : 0; row < src.height && y + row < t.height; row++) {
+        uint32_t lo = src.rowStart[row], hi = src.rowStart[row + 1];
+        // First run ending past srcX
+        while (lo < hi) {
+            uint32_t mid = (lo + hi) / 2;
+            if (src.runs[mid].x1 <= srcX) lo = mid + 1; else hi = mid;
+        }
+        const uint16_t* s = src.buf + row * src.width;
+        uint16_t*       d = t.buf + (y + row) * t.width + x - srcX;
+        for (uint32_t k = lo; k < src.rowStart[row + 1] && src.runs[k].x0 < srcEnd; k++) {
+            int a = src.runs[k].x0 > srcX   ? src.runs[k].x0 : srcX;
+            int b = src.runs[k].x1 < srcEnd ? src.runs[k].x1 : srcEnd;
+            memcpy(d + a, s + a, (b - a) * 2);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+// DirtyRegion.h - Small set of screen rectangles touched since the last push
+//
+// Rectangles are clipped to the screen on add.  A new rect is folded into an
+// existing one when their union wastes little area; once the list is full the
+// cheapest pair is merged.  When the covered area passes DIRTY_FULL_PUSH_PCT
+// of the screen the region collapses to a single full-screen rect.
+
+#include <Arduino.h>
+#include "config.h"
+
+struct DirtyRect {
+    int x, y, w, h;
+    int area()  const { return w * h; }
+    int right() const { return x + w; }
+    int bottom()const { return y + h; }
+};
+
+static inline DirtyRect unionRect(const DirtyRect& a, const DirtyRect& b) {
+    int x0 = min(a.x, b.x),           y0 = min(a.y, b.y);
+    int x1 = max(a.right(), b.right()), y1 = max(a.bottom(), b.bottom());
+    return { x0, y0, x1 - x0, y1 - y0 };
+}
+
+class DirtyRegion {
+public:
+    DirtyRegion(int screenW = DISPLAY_WIDTH, int screenH = DISPLAY_HEIGHT)
+        : _sw(screenW), _sh(screenH), _count(0), _full(false) {}
+
+    void reset()   { _count = 0; _full = false; }
+    void markAll() { _count = 1; _rects[0] = { 0, 0, _sw, _sh }; _full = true; }
+
+    bool empty() const { return _count == 0; }
+    bool full()  const { return _full; }
+    int  count() const { return _count; }
+    const DirtyRect& rect(int i) const { return _rects[i]; }
+
+    int area() const {
+        int a = 0;
+        for (int i = 0; i < _count; i++) a += _rects[i].area();
+        return a;
+    }
+
+    void add(int x, int y, int w, int h) {
+        if (_full) return;
+        if (x < 0) { w += x; x = 0; }
+        if (y < 0) { h += y; y = 0; }
+        if (x + w > _sw) w = _sw - x;
+        if (y + h > _sh) h = _sh - y;
+        if (w <= 0 || h <= 0) return;
+
+        DirtyRect r = { x, y, w, h };
+
+        // Fold into an existing rect when the union wastes little area
+        for (int i = 0; i < _count; i++) {
+            DirtyRect u = unionRect(_rects[i], r);
+            if (u.area() <= _rects[i].area() + r.area() + DIRTY_MERGE_SLACK) {
+                _rects[i] = u;
+                _afterGrow();
+                return;
+            }
+        }
+
+        if (_count == DIRTY_MAX_RECTS) _mergeCheapestPair();
+        _rects[_count++] = r;
+        _afterGrow();
+    }
+
+    void add(const DirtyRect& r) { add(r.x, r.y, r.w, r.h); }
+
+private:
+    DirtyRect _rects[DIRTY_MAX_RECTS];
+    int       _sw, _sh;
+    int       _count;
+    bool      _full;
+
+    void _afterGrow() {
+        if (area() * 100 >= _sw * _sh * DIRTY_FULL_PUSH_PCT) markAll();
+    }
+
+    void _mergeCheapestPair() {
+        int bi = 0, bj = 1, bestGrowth = 0x7FFFFFFF;
+        for (int i = 0; i < _count; i++)
+            for (int j = i + 1; j < _count; j++) {
+                int g = unionRect(_rects[i], _rects[j]).area()
+                      - _rects[i].area() - _rects[j].area();
+                if (g < bestGrowth) { bestGrowth = g; bi = i; bj = j; }
+            }
+        _rects[bi] = unionRect(_rects[bi], _rects[bj]);
+        _rects[bj] = _rects[--_count];
+    }
+};
@@ -0,0 +1,167 @@
+#pragma once
+// DrawList.h - One frame of recorded Renderer calls
+//
+// A recording Renderer appends a DrawCmd per primitive instead of drawing;
+// the raster side replays the list into its canvas.  Commands are plain data
+// and text is copied into a per-list arena, so a finished list doesn't
+// reference anything the simulation may change afterwards (sprite data is
+// const and lives in flash).
+//
+// Lists can be serialized for replay or golden-image comparison.  Sprite and
+// bitmap pointers go through an optional id mapping; without one the raw
+// address is stored, which is only meaningful to the build that recorded it.
+
+#include <stdint.h>
+#include <string.h>
+#include "config.h"
+
+struct Sprite;
+
+enum class DrawOp : uint8_t {
+    Clear, Rect, Line, Pixel, Circle, Triangle, Text, Bitmap, Sprite, FrameDiff
+};
+
+// Flag bits
+static const uint8_t DRAW_FILLED      = 0x01;
+static const uint8_t DRAW_TRANSPARENT = 0x02;
+static const uint8_t DRAW_MIRROR      = 0x04;
+
+struct DrawCmd {
+    DrawOp      op;
+    uint8_t     flags;
+    uint8_t     size;       // text size / bitmap or sprite scale
+    uint16_t    fg, bg;     // bg is the fill color for sprites
+    int16_t     v[6];       // coordinates; layout depends on op
+    int32_t     arg;        // sprite frame / text offset into the arena
+    const void* data;       // bitmap bytes or Sprite*
+};
+
+class DrawList {
+public:
+    DrawList() { reset(); }
+
+    void reset() { _count = 0; _textUsed = 0; _dropped = 0; }
+
+    int            count()   const { return _count; }
+    const DrawCmd& cmd(int i) const { return _cmds[i]; }
+    DrawCmd&       cmd(int i)       { return _cmds[i]; }
+    const char*    text(const DrawCmd& c) const { return _text + c.arg; }
+    // Commands lost because the list or text arena was full
+    int            dropped() const { return _dropped; }
+
+    // True if a command carrying textBytes of text would not fit
+    bool full(int textBytes = 0) const {
+        return _count == DRAW_LIST_MAX_CMDS || _textUsed + textBytes > DRAW_LIST_TEXT_BYTES;
+    }
+
+    // Keep only the first n commands (after in-place compaction)
+    void truncate(int n) { if (n < _count) _count = n; }
+
+    // Returns a zeroed command to fill in, or nullptr when full
+    DrawCmd* add(DrawOp op) {
+        if (_count == DRAW_LIST_MAX_CMDS) { _dropped++; return nullptr; }
+        DrawCmd* c = &_cmds[_count++];
+        memset(c, 0, sizeof(*c));
+        c->op = op;
+        return c;
+    }
+
+    // Text command with its string copied into the arena
+    DrawCmd* addText(const char* s) {
+        int n = (int)strlen(s) + 1;
+        if (_textUsed + n > DRAW_LIST_TEXT_BYTES) { _dropped++; return nullptr; }
+        DrawCmd* c = add(DrawOp::Text);
+        if (!c) return nullptr;
+        memcpy(_text + _textUsed, s, n);
+        c->arg = _textUsed;
+        _textUsed += n;
+        return c;
+    }
+
+    // FNV-1a over the commands and text in use
+    uint32_t checksum() const {
+        uint32_t h = 2166136261u;
+        auto mix = [&h](const void* p, size_t n) {
+            const uint8_t* b = (const uint8_t*)p;
+            for (size_t i = 0; i < n; i++) h = (h ^ b[i]) * 16777619u;
+        };
+        mix(_cmds, (size_t)_count * sizeof(DrawCmd));
+        mix(_text, (size_t)_textUsed);
+        mix(&_count, sizeof(_count));
+        return h;
+    }
+
+    // ── Serialization ────────────────────────────────────────────────────
+    typedef uint32_t    (*PtrToId)(const void* p);
+    typedef const void* (*IdToPtr)(uint32_t id);
+
+    static const uint32_t MAGIC       = 0x54534C44;   // "DLST"
+    static const int      VERSION     = 1;
+    static const int      HEADER_SIZE = 12;
+    static const int      RECORD_SIZE = 32;
+
+    size_t serializedSize() const { return HEADER_SIZE + (size_t)_count * RECORD_SIZE + _textUsed; }
+
+    // Returns bytes written, or 0 if cap is too small
+    size_t serialize(uint8_t* out, size_t cap, PtrToId toId = nullptr) const {
+        if (cap < serializedSize()) return 0;
+        uint8_t* p = out;
+        _put32(p, MAGIC); _put16(p, VERSION); _put16(p, _count);
+        _put16(p, _textUsed); _put16(p, 0);
+        for (int i = 0; i < _count; i++) {
+            const DrawCmd& c = _cmds[i];
+            *p++ = (uint8_t)c.op; *p++ = c.flags; *p++ = c.size; *p++ = 0;
+            _put16(p, c.fg); _put16(p, c.bg);
+            for (int k = 0; k < 6; k++) _put16(p, (uint16_t)c.v[k]);
+            _put32(p, (uint32_t)c.arg);
+            uint64_t ref = !c.data ? 0 : toId ? toId(c.data) : (uint64_t)(uintptr_t)c.data;
+            _put32(p, (uint32_t)ref); _put32(p, (uint32_t)(ref >> 32));
+        }
+        memcpy(p, _text, _textUsed);
+        return serializedSize();
+    }
+
+    // Replaces the contents; returns false (leaving the list empty) on a
+    // malformed or foreign stream: bad header, unknown op, a Text command
+    // whose offset is outside the text, or text not ending in a NUL
+    bool deserialize(const uint8_t* in, size_t len, IdToPtr toPtr = nullptr) {
+        reset();
+        if (len < (size_t)HEADER_SIZE) return false;
+        const uint8_t* p = in;
+        if (_get32(p) != MAGIC || _get16(p) != VERSION) return false;
+        int count = _get16(p), textUsed = _get16(p);
+        _get16(p);
+        if (count > DRAW_LIST_MAX_CMDS || textUsed > DRAW_LIST_TEXT_BYTES
+            || len < HEADER_SIZE + (size_t)count * RECORD_SIZE + textUsed) return false;
+        for (int i = 0; i < count; i++) {
+            DrawCmd& c = _cmds[i];
+            c.op = (DrawOp)*p++; c.flags = *p++; c.size = *p++; p++;
+            c.fg = _get16(p); c.bg = _get16(p);
+            for (int k = 0; k < 6; k++) c.v[k] = (int16_t)_get16(p);
+            c.arg = (int32_t)_get32(p);
+            uint64_t ref = _get32(p);
+            ref |= (uint64_t)_get32(p) << 32;
+            c.data = !ref ? nullptr : toPtr ? toPtr((uint32_t)ref) : (const void*)(uintptr_t)ref;
+            if (c.op > DrawOp::FrameDiff) return false;
+            if (c.op == DrawOp::Text && (c.arg < 0 || c.arg >= textUsed)) return false;
+        }
+        // Every string must end inside the arena
+        if (textUsed > 0 && p[textUsed - 1] != '\0') return false;
+        memcpy(_text, p, textUsed);
+        _count = count;
+        _textUsed = textUsed;
+        return true;
+    }
+
+private:
+    static void _put16(uint8_t*& p, uint16_t v) { p[0] = v; p[1] = v >> 8; p += 2; }
+    static void _put32(uint8_t*& p, uint32_t v) { _put16(p, v); _put16(p, v >> 16); }
+    static uint16_t _get16(const uint8_t*& p) { uint16_t v = p[0] | (p[1] << 8); p += 2; return v; }
+    static uint32_t _get32(const uint8_t*& p) { uint32_t v = _get16(p); return v | ((uint32_t)_get16(p) << 16); }
+
+    DrawCmd _cmds[DRAW_LIST_MAX_CMDS];
+    char    _text[DRAW_LIST_TEXT_BYTES];
+    int     _count;
+    int     _textUsed;
+    int     _dropped;
+};
@@ -19,7 +19,7 @@ static const int MAX_ENV_OBJECTS = 32;
 
 struct EnvObject {
     const Sprite* sprite  = nullptr;
-    float         x       = 0;
+    float         x       = 0;      // move with Environment::moveObject()
     float         y       = 0;
     int           frame   = 0;      // current frame (can be animated externally)
     float         rotate  = 0.0f;  // degrees (unused for now, reserved)
@@ -35,6 +35,18 @@ static const int MAX_DRAW_CALLBACKS = 8;
 struct DrawCb { DrawCallback fn; Layer layer; void* data; bool active; };
 
 // ── Environment ────────────────────────────────────────────────────────────
+// Objects live in fixed slots, so the pointer addObject() returns stays
+// valid until removeObject(), and removed slots go on a free list for the
+// next add.  Each layer keeps its objects' slots sorted by world x: draw()
+// binary-searches the first one that can reach the screen at the layer's
+// parallax and stops at the first past the right edge, so its cost follows
+// what is on screen rather than how wide the world is.  The visible ones
+// still draw in the order they were added, so overlaps stack as placed.
+//
+// Every layer is drawn from its objects and callbacks each frame.  The
+// background and midground are not pre-rendered: no scene places objects on
+// them, and their one callback, the outdoor sky, animates.  The static
+// scenery all sits in the foreground, which scrolls with the camera.
 
 class Environment {
 public:
@@ -42,13 +54,19 @@ public:
     float worldWidth;
 
     Environment(float worldWidth = 256.0f * SPRITE_SCALE)
-        : worldWidth(worldWidth), cameraX(0.0f), _objCount(0), _cbCount(0) {}
+        : cameraX(0.0f), worldWidth(worldWidth), _nextSeq(0), _cbCount(0) {
+        for (int i = 0; i < MAX_ENV_OBJECTS; i++) _nextFree[i] = (uint8_t)(i + 1);
+        _freeHead = 0;
+        for (Bucket& b : _buckets) { b.count = 0; b.maxWidth = 0; }
+    }
 
     // ── Object management ──────────────────────────────────────────────
     EnvObject* addObject(Layer layer, const Sprite* sprite, float wx, float wy,
                          bool mirror_h = false) {
-        if (_objCount >= MAX_ENV_OBJECTS) return nullptr;
-        EnvObject& o = _objects[_objCount++];
+        if (_freeHead >= MAX_ENV_OBJECTS) return nullptr;
+        int i = _freeHead;
+        _freeHead = _nextFree[i];
+        EnvObject& o = _objects[i];
         o.sprite   = sprite;
         o.x        = wx;
         o.y        = wy;
@@ -56,17 +74,40 @@ public:
         o.mirror_h = mirror_h;
         o.active   = true;
         o.rotate   = 0;
-        _layerOf[_objCount - 1] = layer;
+        _layerOf[i] = layer;
+        _seq[i]     = _nextSeq++;
+
+        Bucket& b = _buckets[layer];
+        int k = b.count++;
+        while (k > 0 && _objects[b.slot[k - 1]].x > wx) { b.slot[k] = b.slot[k - 1]; k--; }
+        b.slot[k] = (uint8_t)i;
+        if (sprite) b.maxWidth = max(b.maxWidth, (int)sprite->width * SPRITE_SCALE);
         return &o;
     }
 
     void removeObject(const EnvObject* ptr) {
-        for (int i = 0; i < _objCount; i++) {
-            if (&_objects[i] == ptr) {
-                _objects[i].active = false;
-                return;
-            }
-        }
+        int i = _slotOf(ptr);
+        if (i < 0) return;
+        Bucket& b = _buckets[_layerOf[i]];
+        int k = _posIn(b, i);
+        for (; k < b.count - 1; k++) b.slot[k] = b.slot[k + 1];
+        b.count--;
+        _objects[i].active = false;
+        _nextFree[i] = (uint8_t)_freeHead;
+        _freeHead    = i;
+    }
+
+    // Move an object, keeping its layer sorted
+    void moveObject(EnvObject* ptr, float wx, float wy) {
+        int i = _slotOf(ptr);
+        if (i < 0) return;
+        ptr->x = wx;
+        ptr->y = wy;
+        Bucket& b = _buckets[_layerOf[i]];
+        int k = _posIn(b, i);
+        while (k > 0 && _objects[b.slot[k - 1]].x > wx)             { b.slot[k] = b.slot[k - 1]; k--; }
+        while (k < b.count - 1 && _objects[b.slot[k + 1]].x < wx)   { b.slot[k] = b.slot[k + 1]; k++; }
+        b.slot[k] = (uint8_t)i;
     }
 
     void addCustomDraw(Layer layer, DrawCallback fn, void* data = nullptr) {
@@ -87,6 +128,7 @@ public:
 
     // ── Draw ──────────────────────────────────────────────────────────
     void draw(Renderer& r) {
+        ProfileScope prof(ProfZone::EnvironmentDraw);
         for (int layer = 0; layer < LAYER_COUNT; layer++) {
             float par = PARALLAX[layer];
             float camOff = cameraX * par;
@@ -97,30 +139,69 @@ public:
                     _callbacks[c].fn(r, cameraX, par, _callbacks[c].data);
             }
 
-            // Static objects
-            for (int i = 0; i < _objCount; i++) {
-                if (!_objects[i].active) continue;
-                if (_layerOf[i] != layer) continue;
+            // Static objects: collect the visible ones in add order
+            const Bucket& b = _buckets[layer];
+            uint8_t vis[MAX_ENV_OBJECTS];
+            int     visCount = 0;
+            for (int k = _firstFrom(b, camOff - b.maxWidth - 1.0f); k < b.count; k++) {
+                int i = b.slot[k];
                 const EnvObject& o = _objects[i];
-                if (!o.sprite) continue;
+                int sx = (int)(o.x - camOff);
+                if (sx > DISPLAY_WIDTH) break;
+                if (!o.sprite || sx + o.sprite->width * SPRITE_SCALE < 0) continue;
+                int v = visCount++;
+                while (v > 0 && _seq[vis[v - 1]] > _seq[i]) { vis[v] = vis[v - 1]; v--; }
+                vis[v] = (uint8_t)i;
+            }
 
+            for (int v = 0; v < visCount; v++) {
+                const EnvObject& o = _objects[vis[v]];
                 int sx = (int)(o.x - camOff);
                 int sy = (int)(o.y) + PLAY_Y;
-
-                // Cull off-screen
-                int sw = o.sprite->width * SPRITE_SCALE;
-                if (sx + sw < 0 || sx > DISPLAY_WIDTH) continue;
-
                 r.drawSpriteObj(o.sprite, sx, sy, o.frame, o.mirror_h);
             }
         }
     }
 
 private:
+    struct Bucket {
+        uint8_t slot[MAX_ENV_OBJECTS];   // sorted by _objects[slot].x
+        int     count;
+        int     maxWidth;                // widest sprite ever added, px
+    };
+
     EnvObject _objects[MAX_ENV_OBJECTS];
     Layer     _layerOf[MAX_ENV_OBJECTS];
-    int       _objCount;
+    uint32_t  _seq[MAX_ENV_OBJECTS];       // add order, for draw order
+    uint32_t  _nextSeq;
+    uint8_t   _nextFree[MAX_ENV_OBJECTS];  // free list; MAX_ENV_OBJECTS ends it
+    int       _freeHead;
+    Bucket    _buckets[LAYER_COUNT];
 
     DrawCb    _callbacks[MAX_DRAW_CALLBACKS];
     int       _cbCount;
+
+    // Slot of a live object, or -1
+    int _slotOf(const EnvObject* ptr) const {
+        int i = (int)(ptr - _objects);
+        return (ptr >= _objects && i < MAX_ENV_OBJECTS && ptr->active) ? i : -1;
+    }
+
+    static int _posIn(const Bucket& b, int slot) {
+        int k = 0;
+        while (b.slot[k] != slot) k++;
+        return k;
+    }
+
+    // First position in b whose object has x >= wx
+    int _firstFrom(const Bucket& b, float wx) const {
+        int lo = 0, hi = b.count;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (_objects[b.slot[mid]].x < wx) lo = mid + 1;
+            else                              hi = mid;
+        }
+        return lo;
+    }
 };
+static_assert(MAX_ENV_OBJECTS < 256, "Environment keeps object slots in uint8_t");
@@ -0,0 +1,136 @@
+#pragma once
+// FramePipeline.h - Simulation / rasterization split across two tasks
+//
+// The sim task runs input, scene update and stat upkeep, then records the
+// frame's draw calls into a DrawList.  The raster task replays finished lists
+// into the display Renderer and pushes them.  Lists are handed over through
+// a single-producer / single-consumer ring: the producer only writes _head,
+// the consumer only writes _tail, and each publishes with release ordering
+// after it is done with the slot.
+//
+// On device the tasks are FreeRTOS tasks pinned to separate cores; on a host
+// build they are std::threads, so the same handoff can be run off-device.
+// Host builds also verify every handoff (PIPELINE_VERIFY): the producer
+// stamps each list with its sequence number and a checksum, and the consumer
+// checks the sequence when it takes a list and the checksum both then and
+// when it gives it back, so a list arriving out of order, consumed twice or
+// written while being replayed shows up in the ring's stats.
+
+#include <atomic>
+#include <stdint.h>
+#include "config.h"
+#include "DrawList.h"
+
+#ifndef ARDUINO
+#include <thread>
+#endif
+
+#ifdef ARDUINO
+static const bool PIPELINE_VERIFY = false;
+#else
+static const bool PIPELINE_VERIFY = true;
+#endif
+
+// Handoff faults seen by the consumer (PIPELINE_VERIFY builds only)
+struct DrawListRingStats {
+    uint32_t outOfOrder = 0;   // not the list after the last one consumed
+    uint32_t reread     = 0;   // the list consumed last, again
+    uint32_t torn       = 0;   // contents differ from what was published
+};
+
+template <int N>
+class DrawListRing {
+public:
+    DrawListRing() : _head(0), _tail(0), _lastRead(UINT32_MAX) {}
+
+    // Producer: next free list (reset), or nullptr while the ring is full
+    DrawList* beginWrite() {
+        uint32_t h = _head.load(std::memory_order_relaxed);
+        if (h - _tail.load(std::memory_order_acquire) == N) return nullptr;
+        DrawList* l = &_slots[h % N];
+        l->reset();
+        return l;
+    }
+    void publish() {
+        uint32_t h = _head.load(std::memory_order_relaxed);
+        if (PIPELINE_VERIFY) {
+            _seq[h % N] = h;
+            _sum[h % N] = _slots[h % N].checksum();
+        }
+        _head.store(h + 1, std::memory_order_release);
+    }
+
+    // Consumer: oldest finished list, or nullptr while the ring is empty
+    const DrawList* beginRead() {
+        uint32_t t = _tail.load(std::memory_order_relaxed);
+        if (_head.load(std::memory_order_acquire) == t) return nullptr;
+        if (PIPELINE_VERIFY) {
+            uint32_t seq = _seq[t % N];
+            if (seq == _lastRead)          _stats.reread++;
+            else if (seq != _lastRead + 1) _stats.outOfOrder++;
+            _lastRead = seq;
+            if (_slots[t % N].checksum() != _sum[t % N]) _stats.torn++;
+        }
+        return &_slots[t % N];
+    }
+    void release() {
+        uint32_t t = _tail.load(std::memory_order_relaxed);
+        if (PIPELINE_VERIFY && _slots[t % N].checksum() != _sum[t % N]) _stats.torn++;
+        _tail.store(t + 1, std::memory_order_release);
+    }
+
+    // Consumer side only, like beginRead()
+    const DrawListRingStats& stats() const { return _stats; }
+
+    // Lists published / consumed so far
+    uint32_t produced() const { return _head.load(std::memory_order_acquire); }
+    uint32_t consumed() const { return _tail.load(std::memory_order_acquire); }
+
+private:
+    DrawList              _slots[N];
+    std::atomic<uint32_t> _head;
+    std::atomic<uint32_t> _tail;
+    uint32_t              _seq[N];     // PIPELINE_VERIFY: stamped by publish()
+    uint32_t              _sum[N];
+    uint32_t              _lastRead;   // consumer: seq of the last list taken
+    DrawListRingStats     _stats;
+};
+
+// ── Tasks ──────────────────────────────────────────────────────────────────
+
+typedef void (*PipelineTaskFn)(void* arg);
+
+// Give up the CPU while waiting on the ring
+static inline void pipelineYield() {
+#ifdef ARDUINO
+    vTaskDelay(1);
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// Task loops run while this is set.  The device never clears it; host
+// checks do, then wait for pipelineTasks() to reach zero.
+static inline std::atomic<bool>& pipelineRunning() { static std::atomic<bool> r{ false }; return r; }
+static inline std::atomic<int>&  pipelineTasks()   { static std::atomic<int>  n{ 0 };     return n; }
+
+// Run fn(arg) on its own task until it returns (core is ignored off-device)
+static inline void startPipelineTask(PipelineTaskFn fn, void* arg, const char* name,
+                                     int core, uint32_t stackBytes) {
+    pipelineRunning() = true;
+    pipelineTasks()++;
+#ifdef ARDUINO
+    xTaskCreatePinnedToCore(fn, name, stackBytes, arg, 1, nullptr, core);
+#else
+    (void)name; (void)core; (void)stackBytes;
+    std::thread([fn, arg]() { fn(arg); pipelineTasks()--; }).detach();
+#endif
+}
+
+// End of a task function: FreeRTOS tasks must delete themselves
+static inline void endPipelineTask() {
+#ifdef ARDUINO
+    pipelineTasks()--;
+    vTaskDelete(nullptr);
+#endif
+}
@@ -1,20 +1,34 @@
 #pragma once
 // GameContext.h - All pet stats and persistent game state
+// (saved and loaded by Persistence.h)
 
 #include <Arduino.h>
-#include <Preferences.h>
+#include "StatDynamics.h"
 
 // Maximum inventory slots per category
 static const int INV_MAX_TOYS   = 8;
 static const int INV_MAX_SNACKS = 8;
 
+// Every item that can be in the inventory; saves store catalog indices
+static const char* const TOY_CATALOG[]   = {"Feather", "Yarn ball", "Laser"};
+static const char* const SNACK_CATALOG[] = {"Treat", "Kibble"};
+static const int TOY_CATALOG_COUNT   = sizeof(TOY_CATALOG)   / sizeof(TOY_CATALOG[0]);
+static const int SNACK_CATALOG_COUNT = sizeof(SNACK_CATALOG) / sizeof(SNACK_CATALOG[0]);
+
+// Catalog index of name, 0xFF for none or an unknown item
+static inline uint8_t inventoryIndex(const char* const* catalog, int count, const char* name) {
+    if (!name) return 0xFF;
+    for (int i = 0; i < count; i++) if (strcmp(catalog[i], name) == 0) return (uint8_t)i;
+    return 0xFF;
+}
+
 struct Inventory {
     // Toy names (null = empty slot)
-    const char* toys[INV_MAX_TOYS]   = {"Feather", "Yarn ball", "Laser", nullptr};
+    const char* toys[INV_MAX_TOYS]   = {TOY_CATALOG[0], TOY_CATALOG[1], TOY_CATALOG[2], nullptr};
     int         toyCount             = 3;
 
     // Snack names
-    const char* snacks[INV_MAX_SNACKS] = {"Treat", "Kibble", nullptr};
+    const char* snacks[INV_MAX_SNACKS] = {SNACK_CATALOG[0], SNACK_CATALOG[1], nullptr};
     int         snackCount             = 2;
 };
 
@@ -27,40 +41,13 @@ struct EnvironmentCtx {
 };
 
 struct GameContext {
-    // ── Rapidly changing (daily) ─────────────────────────────────────────
-    float fullness    = 50.0f;  // inverse of hunger
-    float energy      = 50.0f;  // how rested
-    float comfort     = 50.0f;  // physical comfort
-    float playfulness = 50.0f;  // mood to play
-    float focus       = 50.0f;  // concentration
-
-    // ── Medium changing (weekly) ─────────────────────────────────────────
-    float health        = 50.0f;
-    float fulfillment   = 50.0f;
-    float cleanliness   = 50.0f;
-    float curiosity     = 50.0f;
-    float independence  = 50.0f;
-    float sociability   = 50.0f;
-    float routine       = 50.0f;
-    float intelligence  = 50.0f;
-    float resilience    = 50.0f;
-    float maturity      = 50.0f;
-    float grace         = 50.0f;
-    float affection     = 50.0f;
-
-    // ── Slow changing (monthly) ──────────────────────────────────────────
-    float fitness    = 50.0f;
-    float appetite   = 50.0f;
-    float patience   = 50.0f;
-    float charisma   = 50.0f;
-    float craftiness = 50.0f;
-    float serenity   = 50.0f;
-
-    // ── Traits (near-static) ─────────────────────────────────────────────
-    float courage         = 50.0f;
-    float loyalty         = 50.0f;
-    float mischievousness = 50.0f;
-    float dignity         = 50.0f;
+    GameContext() {
+        for (int i = 0; i < STAT_LANES; i++) stats[i] = 50.0f;
+    }
+
+    // ── Stats (0-100), indexed by StatId ────────────────────────────────
+    alignas(16) float stats[STAT_LANES];
+    StatDynamics      dynamics;
 
     // ── Inventory ────────────────────────────────────────────────────────
     Inventory inventory;
@@ -75,122 +62,40 @@ struct GameContext {
     int highScoreMaze      = 0;
     int highScoreBreakout  = 0;
 
+    // ── Wall-clock time of the last stat save (0 = unknown) ──────────────
+    uint32_t savedAt = 0;
+
     // ── Behavior override (set by behavior system) ───────────────────────
     const char* overrideNextBehavior = nullptr;
 
     // ── Helpers ──────────────────────────────────────────────────────────
-    float getStat(const char* name) const {
-        if (strcmp(name,"fullness")    ==0) return fullness;
-        if (strcmp(name,"energy")      ==0) return energy;
-        if (strcmp(name,"comfort")     ==0) return comfort;
-        if (strcmp(name,"playfulness") ==0) return playfulness;
-        if (strcmp(name,"focus")       ==0) return focus;
-        if (strcmp(name,"health")      ==0) return health;
-        if (strcmp(name,"fulfillment") ==0) return fulfillment;
-        if (strcmp(name,"cleanliness") ==0) return cleanliness;
-        if (strcmp(name,"curiosity")   ==0) return curiosity;
-        if (strcmp(name,"independence")==0) return independence;
-        if (strcmp(name,"sociability") ==0) return sociability;
-        if (strcmp(name,"routine")     ==0) return routine;
-        if (strcmp(name,"intelligence")==0) return intelligence;
-        if (strcmp(name,"resilience")  ==0) return resilience;
-        if (strcmp(name,"maturity")    ==0) return maturity;
-        if (strcmp(name,"grace")       ==0) return grace;
-        if (strcmp(name,"affection")   ==0) return affection;
-        if (strcmp(name,"fitness")     ==0) return fitness;
-        if (strcmp(name,"appetite")    ==0) return appetite;
-        if (strcmp(name,"patience")    ==0) return patience;
-        if (strcmp(name,"charisma")    ==0) return charisma;
-        if (strcmp(name,"craftiness")  ==0) return craftiness;
-        if (strcmp(name,"serenity")    ==0) return serenity;
-        if (strcmp(name,"courage")     ==0) return courage;
-        if (strcmp(name,"loyalty")     ==0) return loyalty;
-        if (strcmp(name,"mischievousness")==0) return mischievousness;
-        if (strcmp(name,"dignity")     ==0) return dignity;
-        return 50.0f;
-    }
+    float getStat(StatId id) const { return stats[(int)id]; }
 
-    void setStat(const char* name, float v) {
-        v = max(0.0f, min(100.0f, v));
-        if (strcmp(name,"fullness")    ==0) { fullness    = v; return; }
-        if (strcmp(name,"energy")      ==0) { energy      = v; return; }
-        if (strcmp(name,"comfort")     ==0) { comfort     = v; return; }
-        if (strcmp(name,"playfulness") ==0) { playfulness = v; return; }
-        if (strcmp(name,"focus")       ==0) { focus       = v; return; }
-        if (strcmp(name,"health")      ==0) { health      = v; return; }
-        if (strcmp(name,"fulfillment") ==0) { fulfillment = v; return; }
-        if (strcmp(name,"cleanliness") ==0) { cleanliness = v; return; }
-        if (strcmp(name,"curiosity")   ==0) { curiosity   = v; return; }
-        if (strcmp(name,"independence")==0) { independence= v; return; }
-        if (strcmp(name,"sociability") ==0) { sociability = v; return; }
-        if (strcmp(name,"routine")     ==0) { routine     = v; return; }
-        if (strcmp(name,"intelligence")==0) { intelligence= v; return; }
-        if (strcmp(name,"resilience")  ==0) { resilience  = v; return; }
-        if (strcmp(name,"maturity")    ==0) { maturity    = v; return; }
-        if (strcmp(name,"grace")       ==0) { grace       = v; return; }
-        if (strcmp(name,"affection")   ==0) { affection   = v; return; }
-        if (strcmp(name,"fitness")     ==0) { fitness     = v; return; }
-        if (strcmp(name,"appetite")    ==0) { appetite    = v; return; }
-        if (strcmp(name,"patience")    ==0) { patience    = v; return; }
-        if (strcmp(name,"charisma")    ==0) { charisma    = v; return; }
-        if (strcmp(name,"craftiness")  ==0) { craftiness  = v; return; }
-        if (strcmp(name,"serenity")    ==0) { serenity    = v; return; }
-        if (strcmp(name,"courage")     ==0) { courage     = v; return; }
-        if (strcmp(name,"loyalty")     ==0) { loyalty     = v; return; }
-        if (strcmp(name,"mischievousness")==0){mischievousness=v; return;}
-        if (strcmp(name,"dignity")     ==0) { dignity     = v; return; }
+    void setStat(StatId id, float v) {
+        stats[(int)id] = max(0.0f, min(100.0f, v));
     }
 
-    void addStat(const char* name, float delta) {
-        setStat(name, getStat(name) + delta);
+    void addStat(StatId id, float delta) {
+        setStat(id, stats[(int)id] + delta);
     }
 
-    // ── Persistence (ESP32 NVS) ───────────────────────────────────────────
-    void saveEnv() {
-        Preferences p;
-        p.begin("catode_env", false);
-        p.putInt("time",    environment.time_of_day);
-        p.putInt("season",  environment.season);
-        p.putInt("moon",    environment.moon_phase);
-        p.putInt("weather", environment.weather);
-        p.end();
-    }
+    // Once per frame: decay plus the rates behaviors added this frame
+    void tickStats(float dt) { dynamics.tick(stats, dt); }
 
-    void loadEnv() {
-        Preferences p;
-        p.begin("catode_env", true);
-        environment.time_of_day = p.getInt("time",    12);
-        environment.season      = p.getInt("season",   0);
-        environment.moon_phase  = p.getInt("moon",     4);
-        environment.weather     = p.getInt("weather",  0);
-        p.end();
+    // By name, for callers that only have a string; unknown names read as 50
+    // and ignore writes
+    float getStat(const char* name) const {
+        StatId id = statIdFromName(name);
+        return id == StatId::Count ? 50.0f : getStat(id);
     }
 
-    void savePetStats() {
-        Preferences p;
-        p.begin("catode_pet", false);
-        p.putFloat("fullness",    fullness);
-        p.putFloat("energy",      energy);
-        p.putFloat("affection",   affection);
-        p.putFloat("cleanliness", cleanliness);
-        p.putFloat("playfulness", playfulness);
-        p.putFloat("comfort",     comfort);
-        p.putFloat("curiosity",   curiosity);
-        p.putFloat("serenity",    serenity);
-        p.end();
+    void setStat(const char* name, float v) {
+        StatId id = statIdFromName(name);
+        if (id != StatId::Count) setStat(id, v);
     }
 
-    void loadPetStats() {
-        Preferences p;
-        p.begin("catode_pet", true);
-        fullness    = p.getFloat("fullness",    50.0f);
-        energy      = p.getFloat("energy",      60.0f);
-        affection   = p.getFloat("affection",   60.0f);
-        cleanliness = p.getFloat("cleanliness", 80.0f);
-        playfulness = p.getFloat("playfulness", 50.0f);
-        comfort     = p.getFloat("comfort",     60.0f);
-        curiosity   = p.getFloat("curiosity",   40.0f);
-        serenity    = p.getFloat("serenity",    60.0f);
-        p.end();
+    void addStat(const char* name, float delta) {
+        StatId id = statIdFromName(name);
+        if (id != StatId::Count) addStat(id, delta);
     }
 };
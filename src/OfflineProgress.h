@@ -0,0 +1,93 @@
+#pragma once
+// OfflineProgress.h - Advance the pet over time the device was switched off
+//
+// Offline the pet lives the way it does when left alone: idle
+// (IdleBehavior::FX) until a behavior check every
+// IdleBehavior::CHECK_INTERVAL, where a scheduler of its own picks from
+// BEHAVIOR_REGISTRY with cooldowns and repeat penalties on an offline clock;
+// then that behavior's whole run (BehaviorSpan), any chain its
+// nextBehavior() follows, and idle again.  Within each of those segments
+// every rate is constant, so StatDynamics::tick() over the whole segment is
+// exact.  A week offline is some thirty thousand segments instead of seven
+// million frames.
+//
+// Include after the behaviors (main.cpp does, via SceneManager.h).
+
+#include "GameContext.h"
+#include "WallClock.h"
+#include "entities/behaviors/IdleBehavior.h"
+
+static const int OFFLINE_IDLE_FX_COUNT = sizeof(IdleBehavior::FX) / sizeof(IdleBehavior::FX[0]);
+static const int OFFLINE_KNEADING      = BEHAVIOR_COUNT;   // chained to, never picked
+
+// Registry runs, then the chain-only kneading
+static const BehaviorSpan* offlineSpans() {
+    static BehaviorSpan spans[BEHAVIOR_COUNT + 1];
+    static bool built = false;
+    if (!built) {
+        for (int i = 0; i < BEHAVIOR_COUNT; i++) spans[i] = BEHAVIOR_REGISTRY[i].span();
+        spans[OFFLINE_KNEADING] = behaviorSpan<KneadingBehavior>();
+        built = true;
+    }
+    return spans;
+}
+
+static int offlineIndex(BaseBehavior* (*make)(CharacterEntity*)) {
+    for (int i = 0; i < BEHAVIOR_COUNT; i++)
+        if (BEHAVIOR_REGISTRY[i].make == make) return i;
+    return -1;
+}
+
+// What a completed run goes on to, as the behaviors' nextBehavior() do:
+// sleeping wakes into a stretch, some stretches run on into kneading, and
+// anything else goes back to idle (-1)
+static int offlineChain(int done) {
+    static const int sleeping   = offlineIndex(makeCandidate<SleepingBehavior>);
+    static const int stretching = offlineIndex(makeCandidate<StretchingBehavior>);
+    if (done == sleeping)   return stretching;
+    if (done == stretching) return random(100) < StretchingBehavior::KNEAD_CHANCE ? OFFLINE_KNEADING : -1;
+    return -1;
+}
+
+// Advance ctx by seconds of unattended time
+static void catchUpOffline(GameContext& ctx, float seconds) {
+    static UtilityScheduler<BEHAVIOR_COUNT> sched(BEHAVIOR_REGISTRY);
+    const BehaviorSpan* spans = offlineSpans();
+    const float idle = (float)timerFrames(IdleBehavior::CHECK_INTERVAL) / FPS;
+    double clock = 0.0;   // seconds, for cooldowns
+    int    cur   = -1;    // running behavior, -1 = idle
+    sched.reset();
+
+    while (seconds > 0.0f) {
+        if (cur < 0) {
+            float t = min(seconds, idle);
+            ctx.dynamics.addRates(IdleBehavior::FX, OFFLINE_IDLE_FX_COUNT);
+            ctx.tickStats(t);
+            seconds -= t;
+            clock   += t;
+            if (t >= idle) cur = sched.pick(ctx.stats, (uint32_t)(clock * 1000.0));
+            continue;
+        }
+        const BehaviorSpan& b = spans[cur];
+        float t = min(seconds, b.seconds);
+        ctx.dynamics.addRates(b.fx, b.fxCount);
+        ctx.tickStats(t);
+        seconds -= t;
+        clock   += t;
+        if (t < b.seconds) break;
+        for (int i = 0; i < b.bonusCount; i++) ctx.addStat(b.bonus[i].stat, b.bonus[i].rate);
+        cur = offlineChain(cur);
+    }
+}
+
+// Catch up from the last save's timestamp to the RTC's current time.  A
+// reading at or before the save means the RTC was reset; nothing is caught up.
+static void catchUpSinceSave(GameContext& ctx) {
+    uint32_t now = wallClockSec();
+    if (!now || !ctx.savedAt || now <= ctx.savedAt) return;
+    float seconds = min((float)(now - ctx.savedAt), OFFLINE_MAX_DAYS * 86400.0f);
+    uint32_t t0 = micros();
+    catchUpOffline(ctx, seconds);
+    Serial.printf("offline %.1f h caught up in %lu us\n",
+                  seconds / 3600.0f, (unsigned long)(micros() - t0));
+}
@@ -0,0 +1,221 @@
+#pragma once
+// Particles.h - Pooled particles for weather and behavior effects
+//
+// Particles live in fixed structure-of-arrays buffers of PARTICLE_MAX, so
+// update() is straight-line passes over contiguous floats: move by velocity,
+// age, then drop the dead by moving the last live one into their slot.
+// Every kind moves in a straight line; what makes snow drift or leaves
+// flutter is applied when drawing.  Emitters add particles at a rate, no
+// more than PARTICLE_FRAME_BUDGET a frame between them, and carry fractions
+// over to the next frame.
+//
+// Weather (WeatherFx) and screen-space effects draw at screen positions;
+// world-space kinds (dust) are shifted by the camera.  One pool is shared,
+// particlePool(); scenes clear it when entered, and a character spawns its
+// behaviors' effects into CharacterEntity::particles when that is set.
+
+#include <Arduino.h>
+#include <math.h>
+#include "config.h"
+#include "Renderer.h"
+
+enum class ParticleKind : uint8_t { Rain, Snow, Leaf, Dust, Count };
+
+struct ParticleStyle {
+    uint16_t color;
+    bool     world;   // world coordinates, drawn minus the camera offset
+};
+
+static const ParticleStyle PARTICLE_STYLES[(int)ParticleKind::Count] = {
+    { 0x949F,           false },   // Rain: pale blue streak
+    { COLOR_WHITE,      false },   // Snow: 2-pixel flake
+    { COLOR_ORANGE,     false },   // Leaf: 2x2, swaying
+    { COLOR_LIGHT_GRAY, true  },   // Dust: puff that shrinks to a dot
+};
+
+// How one emitter spawns: per second, anywhere in a box, with velocity
+// vx/vy plus up to +/- spread, living life seconds (or until past yMax)
+struct EmitterSpec {
+    ParticleKind kind;
+    float        rate;
+    float        x0, x1, y0, y1;
+    float        vx, vy, spreadX, spreadY;
+    float        life;
+    float        yMax;
+};
+
+class ParticleSystem {
+public:
+    ParticleSystem() : _count(0), _budget(PARTICLE_FRAME_BUDGET), _rng(0x9E3779B9u) {}
+
+    // Add one particle; false if the pool or this frame's budget is spent
+    bool spawn(ParticleKind kind, float x, float y, float vx, float vy, float life) {
+        if (_count >= PARTICLE_MAX || _budget <= 0) return false;
+        int i = _count++;
+        _budget--;
+        _x[i] = x;   _y[i] = y;
+        _vx[i] = vx; _vy[i] = vy;
+        _life[i] = life;
+        _age[i]  = 0.0f;
+        _kind[i] = kind;
+        return true;
+    }
+
+    // Spawn rate * dt particles of s, carrying the fraction in carry
+    void emit(const EmitterSpec& s, float dt, float& carry, float dx = 0.0f, float dy = 0.0f) {
+        carry += s.rate * dt;
+        while (carry >= 1.0f) {
+            float x  = dx + s.x0 + (s.x1 - s.x0) * _unit();
+            float y  = dy + s.y0 + (s.y1 - s.y0) * _unit();
+            float vx = s.vx + s.spreadX * (2.0f * _unit() - 1.0f);
+            float vy = s.vy + s.spreadY * (2.0f * _unit() - 1.0f);
+            float life = s.life;
+            if (vy > 0.0f && s.yMax + dy > y) life = min(life, (s.yMax + dy - y) / vy);
+            if (!spawn(s.kind, x, y, vx, vy, life)) { carry = 0.0f; return; }
+            carry -= 1.0f;
+        }
+    }
+
+    // Move and age everything by dt, drop the expired, and reset the
+    // spawn budget for the next frame
+    void update(float dt) {
+        const int n = _count;
+        float* __restrict x  = _x;
+        float* __restrict y  = _y;
+        float* __restrict a  = _age;
+        const float* __restrict vx = _vx;
+        const float* __restrict vy = _vy;
+        for (int i = 0; i < n; i++) {
+            x[i] += vx[i] * dt;
+            y[i] += vy[i] * dt;
+            a[i] += dt;
+        }
+        int live = n;
+        for (int i = 0; i < live;) {
+            if (_age[i] < _life[i]) { i++; continue; }
+            live--;
+            _x[i] = _x[live];     _y[i] = _y[live];
+            _vx[i] = _vx[live];   _vy[i] = _vy[live];
+            _life[i] = _life[live]; _age[i] = _age[live];
+            _kind[i] = _kind[live];
+        }
+        _count  = live;
+        _budget = PARTICLE_FRAME_BUDGET;
+    }
+
+    void draw(Renderer& r, int cameraOffset = 0) const { _draw(r, cameraOffset, true, true); }
+
+    // One side only, for scenes that layer weather behind the ground and
+    // world effects over it
+    void drawScreen(Renderer& r) const { _draw(r, 0, true, false); }
+    void drawWorld(Renderer& r, int cameraOffset) const { _draw(r, cameraOffset, false, true); }
+
+    void clear() { _count = 0; }
+    int  count() const { return _count; }
+
+private:
+    void _draw(Renderer& r, int cameraOffset, bool screen, bool world) const {
+        for (int i = 0; i < _count; i++) {
+            const ParticleStyle& st = PARTICLE_STYLES[(int)_kind[i]];
+            if (!(st.world ? world : screen)) continue;
+            int px = (int)_x[i] - (st.world ? cameraOffset : 0);
+            int py = (int)_y[i];
+            switch (_kind[i]) {
+                case ParticleKind::Rain:
+                    r.drawLine(px, py, px - 1, py + 5, st.color);
+                    break;
+                case ParticleKind::Snow:
+                    px += (int)(2.0f * sinf(_age[i] * 2.0f + i));
+                    r.drawRect(px, py, 2, 1, st.color, true);
+                    break;
+                case ParticleKind::Leaf:
+                    px += (int)(6.0f * sinf(_age[i] * 3.0f + i));
+                    r.drawRect(px, py, 2, 2, st.color, true);
+                    break;
+                default:   // Dust
+                    if (_age[i] < 0.5f * _life[i]) r.drawRect(px, py, 2, 2, st.color, true);
+                    else                            r.drawPixel(px, py, st.color);
+                    break;
+            }
+        }
+    }
+
+    alignas(16) float _x[PARTICLE_MAX];
+    alignas(16) float _y[PARTICLE_MAX];
+    alignas(16) float _vx[PARTICLE_MAX];
+    alignas(16) float _vy[PARTICLE_MAX];
+    alignas(16) float _life[PARTICLE_MAX];   // seconds it lives
+    alignas(16) float _age[PARTICLE_MAX];
+    ParticleKind      _kind[PARTICLE_MAX];
+    int               _count;
+    int               _budget;   // spawns left this frame
+    uint32_t          _rng;      // own generator, so effects don't shift random()
+
+    float _unit() {
+        _rng = _rng * 1664525u + 1013904223u;
+        return (_rng >> 8) * (1.0f / 16777216.0f);
+    }
+};
+
+static inline ParticleSystem& particlePool() {
+    static ParticleSystem p;
+    return p;
+}
+
+// Kicked up behind a running character: world coordinates relative to its
+// feet
+static const EmitterSpec DUST_PUFFS = { ParticleKind::Dust, 14.0f, -6.0f, 6.0f, -3.0f, 0.0f,
+                                        0.0f, -10.0f, 25.0f, 6.0f, 0.6f, 0.0f };
+
+// ── Weather ─────────────────────────────────────────────────────────────────
+
+// Emitters for the outdoor weather: falling across the sky band down to the
+// ground line, denser as the weather gets heavier
+static const float WEATHER_GROUND_Y = PLAY_Y + PLAY_HEIGHT - 1;
+
+static const EmitterSpec WEATHER_RAIN  = { ParticleKind::Rain,  60.0f, 0, DISPLAY_WIDTH, PLAY_Y - 6, PLAY_Y,
+                                           -12.0f, 160.0f, 4.0f, 20.0f, 2.0f, WEATHER_GROUND_Y };
+static const EmitterSpec WEATHER_STORM = { ParticleKind::Rain, 150.0f, 0, DISPLAY_WIDTH, PLAY_Y - 6, PLAY_Y,
+                                           -40.0f, 220.0f, 8.0f, 30.0f, 2.0f, WEATHER_GROUND_Y };
+static const EmitterSpec WEATHER_SNOW  = { ParticleKind::Snow,  16.0f, 0, DISPLAY_WIDTH, PLAY_Y - 2, PLAY_Y,
+                                            0.0f,  22.0f, 6.0f,  6.0f, 8.0f, WEATHER_GROUND_Y };
+static const EmitterSpec WEATHER_LEAVES = { ParticleKind::Leaf,  1.5f, 0, DISPLAY_WIDTH, PLAY_Y - 2, PLAY_Y,
+                                            8.0f,  18.0f, 8.0f,  4.0f, 10.0f, WEATHER_GROUND_Y };
+
+// Weather and season -> emitters, plus the storm's lightning flashes
+class WeatherFx {
+public:
+    WeatherFx() : _flash(0.0f), _nextFlash(4.0f), _rng(0x2545F491u) {
+        for (float& c : _carry) c = 0.0f;
+    }
+
+    // weather/season as in EnvironmentCtx
+    void update(ParticleSystem& ps, int weather, int season, float dt) {
+        const EmitterSpec* fall = weather == 2 ? &WEATHER_RAIN
+                                : weather == 3 ? &WEATHER_STORM
+                                : weather == 4 ? &WEATHER_SNOW : nullptr;
+        if (fall) ps.emit(*fall, dt, _carry[0]);
+        if (season == 2 && weather < 4) ps.emit(WEATHER_LEAVES, dt, _carry[1]);
+
+        _flash = max(0.0f, _flash - dt);
+        if (weather != 3) return;
+        _nextFlash -= dt;
+        if (_nextFlash <= 0.0f) {
+            _flash     = 0.15f;
+            _nextFlash = 3.0f + (float)(_hash() % 60) / 10.0f;
+        }
+    }
+
+    // Lightning over the sky band; draw after the sky, before particles
+    void drawFlash(Renderer& r) const {
+        if (_flash > 0.0f) r.drawRect(0, PLAY_Y, DISPLAY_WIDTH, PLAY_HEIGHT * 2 / 3, COLOR_LIGHT_GRAY, true);
+    }
+
+private:
+    float    _carry[2];   // falling weather, leaves
+    float    _flash;      // seconds of flash left
+    float    _nextFlash;
+    uint32_t _rng;
+
+    uint32_t _hash() { _rng = _rng * 1664525u + 1013904223u; return _rng >> 16; }
+};
@@ -0,0 +1,438 @@
+#pragma once
+// Persistence.h - Saves GameContext to NVS as one CRC-checked binary blob
+//
+// Every frame the saveable state is captured into a SaveBlob and compared
+// with the last blob written, giving a dirty bit per field.  Nothing is
+// written while the state matches.  Settings, scores and inventory are
+// written once they have stopped changing for PERSIST_QUIET_S, so a burst of
+// button presses costs one write.  Stats drift every frame, so they count as
+// dirty only once one has moved by PERSIST_STAT_EPSILON, and are written at
+// most PERSIST_MAX_DELAY_S after that.
+//
+// Saves are journaled.  A full SaveBlob snapshot goes to whichever of two
+// keys ("snap0"/"snap1") doesn't hold the current one.  Every later save
+// appends a JournalRecord instead: the dirty bits and only the values they
+// mark, written to the next of JOURNAL_SLOTS keys in a ring.  Each save is
+// therefore one small write, and writes rotate over many keys instead of
+// rewriting one.  A new snapshot (compaction) is taken once the ring wraps,
+// so every record since the current snapshot is still in flash.
+//
+// Loading takes the valid snapshot with the highest sequence number.  It
+// then replays the valid records taken against that snapshot in sequence,
+// stopping at a gap.  Every write has a CRC and no write modifies the
+// previous good state in place, so a write cut off by power loss leaves the
+// state as of the previous save.  Without any snapshot, the single "save" blob of earlier firmware
+// is used, then the per-key values before that.
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <stddef.h>
+#include "config.h"
+#include "GameContext.h"
+#include "WallClock.h"
+
+static const uint32_t SAVE_MAGIC   = 0x56415343;   // "CSAV"
+static const uint16_t SAVE_VERSION = 1;
+static const int      SAVE_SCORES  = 5;
+
+struct SaveBlob {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    uint32_t writes;                   // lifetime blob writes, for wear
+    uint32_t savedAt;                  // wall clock (s), 0 = unknown
+    float    stats[STAT_COUNT];
+    int8_t   env[4];                   // time_of_day, season, moon_phase, weather
+    int32_t  scores[SAVE_SCORES];      // see _capture()
+    uint8_t  toyCount, snackCount;
+    uint8_t  toys[INV_MAX_TOYS];       // TOY_CATALOG index, 0xFF = empty
+    uint8_t  snacks[INV_MAX_SNACKS];   // SNACK_CATALOG index, 0xFF = empty
+    uint8_t  reserved[2];
+    uint32_t crc;                      // CRC-32 of everything above
+};
+static_assert(sizeof(SaveBlob) == 172, "SaveBlob layout changed: bump SAVE_VERSION");
+
+// Dirty bits: one per stat, then environment, scores and inventory fields
+static const int      PERSIST_BIT_ENV       = STAT_COUNT;
+static const int      PERSIST_BIT_SCORES    = PERSIST_BIT_ENV + 4;
+static const int      PERSIST_BIT_INVENTORY = PERSIST_BIT_SCORES + SAVE_SCORES;
+static const uint64_t PERSIST_STAT_MASK     = (1ull << STAT_COUNT) - 1;
+
+// Bytes of SaveBlob from toyCount up to reserved: the inventory as saved
+static const int PERSIST_INVENTORY_BYTES = offsetof(SaveBlob, reserved) - offsetof(SaveBlob, toyCount);
+
+// One journaled save: what changed since the previous save.  data holds, in
+// bit order of mask, each stat in hundredths of a point (uint16), each
+// environment field (int8), each score (int32) and the inventory.  Only the
+// header and the size bytes of data in use are written.
+static const int JOURNAL_DATA_MAX = STAT_COUNT * 2 + 4 + SAVE_SCORES * 4 + PERSIST_INVENTORY_BYTES;
+
+struct JournalRecord {
+    uint32_t crc;                  // CRC-32 of everything after it that is written
+    uint32_t seq;                  // increases by one per record
+    uint32_t snapSeq;              // SaveBlob::writes of the base snapshot
+    uint32_t savedAt;
+    uint64_t mask;                 // dirty bits of the values in data
+    uint16_t size;                 // bytes of data in use
+    uint16_t reserved;
+    uint8_t  data[JOURNAL_DATA_MAX];
+};
+static const int JOURNAL_HEADER = offsetof(JournalRecord, data);
+static_assert(JOURNAL_HEADER == 28 && JOURNAL_DATA_MAX == 96, "JournalRecord layout changed");
+
+// Counters since boot.  NVS stores data in 32-byte entries, and a blob takes
+// one entry per 32 bytes of data plus a header and an index entry, so
+// `entries` is what the flash actually wears by.
+struct PersistStats {
+    uint32_t writes       = 0;
+    uint32_t snapshots    = 0;
+    uint32_t records      = 0;
+    uint32_t bytes        = 0;
+    uint32_t entries      = 0;
+    uint32_t lifetime     = 0;   // snapshots ever, from the snapshot itself
+    uint64_t lastDirty    = 0;   // dirty mask of the last write
+};
+
+static uint32_t crc32(const void* data, size_t n) {
+    static const uint32_t NIBBLE[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    const uint8_t* p = (const uint8_t*)data;
+    uint32_t c = 0xFFFFFFFF;
+    for (size_t i = 0; i < n; i++) {
+        c ^= p[i];
+        c = (c >> 4) ^ NIBBLE[c & 15];
+        c = (c >> 4) ^ NIBBLE[c & 15];
+    }
+    return ~c;
+}
+
+// Stats the per-key format saved, with their first-boot values
+struct LegacyStat { StatId id; float initial; };
+static const LegacyStat LEGACY_STATS[] = {
+    { StatId::Fullness,    50.0f },
+    { StatId::Energy,      60.0f },
+    { StatId::Affection,   60.0f },
+    { StatId::Cleanliness, 80.0f },
+    { StatId::Playfulness, 50.0f },
+    { StatId::Comfort,     60.0f },
+    { StatId::Curiosity,   40.0f },
+    { StatId::Serenity,    60.0f },
+};
+
+static uint32_t nvsBlobEntries(size_t bytes) { return (uint32_t)((bytes + 31) / 32) + 2; }
+
+class Persistence {
+public:
+    explicit Persistence(GameContext* ctx)
+        : _ctx(ctx), _quiet(0.0f), _age(0.0f), _valid(false),
+          _snapSeq(0), _snapSlot(0), _sinceSnap(0), _nextSeq(1) {
+        memset(&_saved, 0, sizeof(_saved));
+        memset(&_last,  0, sizeof(_last));
+    }
+
+    // Load the newest snapshot plus its records (or the older
+    // formats) into the context
+    void load() {
+        static const char* const SNAP_KEYS[] = { "snap0", "snap1", "save" };
+        SaveBlob b;
+        int      found = -1;
+        Preferences p;
+        p.begin("catode", true);
+        for (int i = 0; i < 3; i++) {
+            SaveBlob c;
+            if (_readSnapshot(p, SNAP_KEYS[i], c) && (found < 0 || c.writes > b.writes)) {
+                b = c;
+                found = i;
+            }
+        }
+
+        // Slots of the snapshot's records, in sequence order
+        uint32_t seqs[JOURNAL_SLOTS];
+        int      slots[JOURNAL_SLOTS];
+        int      count = 0;
+        _nextSeq = 1;
+        for (int i = 0; found >= 0 && i < JOURNAL_SLOTS; i++) {
+            JournalRecord r;
+            if (!_readRecord(p, i, r)) continue;
+            if (r.seq >= _nextSeq) _nextSeq = r.seq + 1;
+            if (r.snapSeq != b.writes) continue;
+            int k = count++;
+            for (; k > 0 && seqs[k - 1] > r.seq; k--) { seqs[k] = seqs[k - 1]; slots[k] = slots[k - 1]; }
+            seqs[k]  = r.seq;
+            slots[k] = i;
+        }
+
+        _sinceSnap = 0;
+        for (int i = 0; i < count && (i == 0 || seqs[i] == seqs[i - 1] + 1); i++) {
+            JournalRecord r;
+            if (!_readRecord(p, slots[i], r) || !_applyRecord(b, r)) break;
+            _sinceSnap = i + 1;
+        }
+        p.end();
+
+        if (found >= 0) {
+            _snapSeq  = b.writes;
+            _snapSlot = found == 1 ? 1 : 0;
+            _valid    = true;
+            _stats.lifetime = b.writes;
+            _restore(b);
+            _saved = b;
+        } else {
+            _loadLegacy();
+        }
+        _capture(_last);
+    }
+
+    // Once per frame
+    void update(float dt) {
+        SaveBlob cur;
+        _capture(cur);
+
+        // Settings/scores/inventory edits restart the quiet window
+        if (memcmp(cur.env, _last.env, offsetof(SaveBlob, crc) - offsetof(SaveBlob, env)) != 0)
+            _quiet = 0.0f;
+        else
+            _quiet += dt;
+        _last = cur;
+
+        uint64_t dirty = _diff(cur);
+        if (!dirty) { _age = 0.0f; return; }
+        _age += dt;
+
+        bool fieldsDirty = (dirty & ~PERSIST_STAT_MASK) != 0;
+        if ((fieldsDirty && _quiet >= PERSIST_QUIET_S) || _age >= PERSIST_MAX_DELAY_S)
+            _write(cur, dirty);
+    }
+
+    // Write now if anything differs from the last save
+    void flush() {
+        SaveBlob cur;
+        _capture(cur);
+        uint64_t dirty = _diff(cur);
+        if (dirty) _write(cur, dirty);
+    }
+
+    // Dirty bits of the current state against the last save
+    uint64_t dirty() const {
+        SaveBlob cur;
+        _capture(cur);
+        return _diff(cur);
+    }
+
+    const PersistStats& stats() const { return _stats; }
+
+private:
+    GameContext* _ctx;
+    SaveBlob     _saved;   // state as of the last save or load
+    SaveBlob     _last;    // previous frame's capture
+    float        _quiet;   // s since settings/scores/inventory last changed
+    float        _age;     // s the current dirty state has been pending
+    bool         _valid;   // a snapshot exists
+    uint32_t     _snapSeq;     // SaveBlob::writes of the current snapshot
+    int          _snapSlot;    // key holding it: 0 = snap0, 1 = snap1
+    int          _sinceSnap;   // records written against it
+    uint32_t     _nextSeq;     // seq of the next record
+    PersistStats _stats;
+
+    int* _score(int i) const {
+        int* const s[SAVE_SCORES] = {
+            &_ctx->zoomiesHighScore, &_ctx->mazeBestTimeSec,
+            &_ctx->highScoreZoomies, &_ctx->highScoreMaze, &_ctx->highScoreBreakout,
+        };
+        return s[i];
+    }
+
+    void _capture(SaveBlob& b) const {
+        memset(&b, 0, sizeof(b));
+        b.magic   = SAVE_MAGIC;
+        b.version = SAVE_VERSION;
+        b.size    = sizeof(b);
+        b.savedAt = _ctx->savedAt;
+        memcpy(b.stats, _ctx->stats, sizeof(b.stats));
+        const EnvironmentCtx& e = _ctx->environment;
+        b.env[0] = (int8_t)e.time_of_day;
+        b.env[1] = (int8_t)e.season;
+        b.env[2] = (int8_t)e.moon_phase;
+        b.env[3] = (int8_t)e.weather;
+        for (int i = 0; i < SAVE_SCORES; i++) b.scores[i] = *_score(i);
+        const Inventory& inv = _ctx->inventory;
+        b.toyCount   = (uint8_t)inv.toyCount;
+        b.snackCount = (uint8_t)inv.snackCount;
+        for (int i = 0; i < INV_MAX_TOYS; i++)   b.toys[i]   = inventoryIndex(TOY_CATALOG,   TOY_CATALOG_COUNT,   inv.toys[i]);
+        for (int i = 0; i < INV_MAX_SNACKS; i++) b.snacks[i] = inventoryIndex(SNACK_CATALOG, SNACK_CATALOG_COUNT, inv.snacks[i]);
+    }
+
+    void _restore(const SaveBlob& b) {
+        memcpy(_ctx->stats, b.stats, sizeof(b.stats));
+        _ctx->savedAt = b.savedAt;
+        EnvironmentCtx& e = _ctx->environment;
+        e.time_of_day = b.env[0];
+        e.season      = b.env[1];
+        e.moon_phase  = b.env[2];
+        e.weather     = b.env[3];
+        for (int i = 0; i < SAVE_SCORES; i++) *_score(i) = b.scores[i];
+        Inventory& inv = _ctx->inventory;
+        inv.toyCount   = min((int)b.toyCount,   INV_MAX_TOYS);
+        inv.snackCount = min((int)b.snackCount, INV_MAX_SNACKS);
+        for (int i = 0; i < INV_MAX_TOYS; i++)
+            inv.toys[i] = b.toys[i] < TOY_CATALOG_COUNT ? TOY_CATALOG[b.toys[i]] : nullptr;
+        for (int i = 0; i < INV_MAX_SNACKS; i++)
+            inv.snacks[i] = b.snacks[i] < SNACK_CATALOG_COUNT ? SNACK_CATALOG[b.snacks[i]] : nullptr;
+    }
+
+    uint64_t _diff(const SaveBlob& cur) const {
+        if (!_valid) return (1ull << (PERSIST_BIT_INVENTORY + 1)) - 1;
+        uint64_t d = 0;
+        for (int i = 0; i < STAT_COUNT; i++)
+            if (fabsf(cur.stats[i] - _saved.stats[i]) >= PERSIST_STAT_EPSILON) d |= 1ull << i;
+        for (int i = 0; i < 4; i++)
+            if (cur.env[i] != _saved.env[i]) d |= 1ull << (PERSIST_BIT_ENV + i);
+        for (int i = 0; i < SAVE_SCORES; i++)
+            if (cur.scores[i] != _saved.scores[i]) d |= 1ull << (PERSIST_BIT_SCORES + i);
+        if (memcmp(&cur.toyCount, &_saved.toyCount,
+                   offsetof(SaveBlob, reserved) - offsetof(SaveBlob, toyCount)) != 0)
+            d |= 1ull << PERSIST_BIT_INVENTORY;
+        return d;
+    }
+
+    void _write(SaveBlob& b, uint64_t dirty) {
+        _ctx->savedAt = wallClockSec();
+        b.savedAt = _ctx->savedAt;
+
+        Preferences p;
+        p.begin("catode", false);
+        if (!_valid || _sinceSnap >= JOURNAL_SLOTS) {
+            // Compaction: a full snapshot in the other slot
+            b.writes = ++_stats.lifetime;
+            b.crc    = crc32(&b, offsetof(SaveBlob, crc));
+            _snapSlot = _valid ? _snapSlot ^ 1 : 0;
+            p.putBytes(_snapSlot ? "snap1" : "snap0", &b, sizeof(b));
+            _snapSeq   = b.writes;
+            _sinceSnap = 0;
+            _stats.snapshots++;
+            _stats.bytes   += sizeof(b);
+            _stats.entries += nvsBlobEntries(sizeof(b));
+            _saved     = b;
+        } else {
+            // Every stat that moved at the record's resolution goes in, not
+            // just those past PERSIST_STAT_EPSILON, so a save is exact
+            uint64_t mask = dirty & ~PERSIST_STAT_MASK;
+            for (int i = 0; i < STAT_COUNT; i++)
+                if (_hundredths(b.stats[i]) != _hundredths(_saved.stats[i])) mask |= 1ull << i;
+            JournalRecord r;
+            _encodeRecord(b, mask, r);
+            char key[8];
+            snprintf(key, sizeof(key), "j%02u", (unsigned)(r.seq % JOURNAL_SLOTS));
+            size_t n = JOURNAL_HEADER + r.size;
+            p.putBytes(key, &r, n);
+            _sinceSnap++;
+            _stats.records++;
+            _stats.bytes   += n;
+            _stats.entries += nvsBlobEntries(n);
+            _applyRecord(_saved, r);   // compare against what a reload would see
+        }
+        p.end();
+
+        _valid = true;
+        _age   = 0.0f;
+        _stats.writes++;
+        _stats.lastDirty = dirty;
+    }
+
+    static bool _readSnapshot(Preferences& p, const char* key, SaveBlob& b) {
+        return p.getBytes(key, &b, sizeof(b)) == sizeof(b)
+            && b.magic == SAVE_MAGIC && b.version == SAVE_VERSION
+            && b.size == sizeof(b) && b.crc == crc32(&b, offsetof(SaveBlob, crc));
+    }
+
+    static bool _readRecord(Preferences& p, int slot, JournalRecord& r) {
+        char key[8];
+        snprintf(key, sizeof(key), "j%02u", (unsigned)slot);
+        size_t n = p.getBytes(key, &r, sizeof(r));
+        return n >= (size_t)JOURNAL_HEADER && n == JOURNAL_HEADER + (size_t)r.size && r.seq != 0
+            && r.crc == crc32((const uint8_t*)&r + 4, n - 4);
+    }
+
+    static uint16_t _hundredths(float v) { return (uint16_t)lroundf(max(0.0f, min(100.0f, v)) * 100.0f); }
+
+    // Bytes one dirty bit's value takes in a record
+    static int _recordBytes(int bit) {
+        return bit < PERSIST_BIT_ENV       ? 2
+             : bit < PERSIST_BIT_SCORES    ? 1
+             : bit < PERSIST_BIT_INVENTORY ? 4
+                                           : PERSIST_INVENTORY_BYTES;
+    }
+
+    // Where one dirty bit's value lives in a SaveBlob; stats are converted
+    static uint8_t* _blobField(SaveBlob& b, int bit) {
+        return bit < PERSIST_BIT_SCORES    ? (uint8_t*)&b.env[bit - PERSIST_BIT_ENV]
+             : bit < PERSIST_BIT_INVENTORY ? (uint8_t*)&b.scores[bit - PERSIST_BIT_SCORES]
+                                           : &b.toyCount;
+    }
+
+    // Record of b's values under mask, sealed with the next seq and a CRC
+    void _encodeRecord(SaveBlob& b, uint64_t mask, JournalRecord& r) {
+        memset(&r, 0, sizeof(r));
+        r.seq     = _nextSeq++;
+        r.snapSeq = _snapSeq;
+        r.savedAt = b.savedAt;
+        r.mask    = mask;
+        uint8_t* d = r.data;
+        for (int bit = 0; bit <= PERSIST_BIT_INVENTORY; bit++) {
+            if (!(mask >> bit & 1)) continue;
+            if (bit < PERSIST_BIT_ENV) {
+                uint16_t v = _hundredths(b.stats[bit]);
+                memcpy(d, &v, 2);
+            } else {
+                memcpy(d, _blobField(b, bit), _recordBytes(bit));
+            }
+            d += _recordBytes(bit);
+        }
+        r.size = (uint16_t)(d - r.data);
+        r.crc  = crc32((const uint8_t*)&r + 4, JOURNAL_HEADER + r.size - 4);
+    }
+
+    // Apply record r's values to b; false if its data doesn't match its mask
+    static bool _applyRecord(SaveBlob& b, const JournalRecord& r) {
+        if (r.mask >> (PERSIST_BIT_INVENTORY + 1)) return false;
+        int size = 0;
+        for (int bit = 0; bit <= PERSIST_BIT_INVENTORY; bit++)
+            if (r.mask >> bit & 1) size += _recordBytes(bit);
+        if (size != r.size) return false;
+
+        const uint8_t* d = r.data;
+        for (int bit = 0; bit <= PERSIST_BIT_INVENTORY; bit++) {
+            if (!(r.mask >> bit & 1)) continue;
+            if (bit < PERSIST_BIT_ENV) {
+                uint16_t v;
+                memcpy(&v, d, 2);
+                b.stats[bit] = min(100.0f, v * 0.01f);
+            } else {
+                memcpy(_blobField(b, bit), d, _recordBytes(bit));
+            }
+            d += _recordBytes(bit);
+        }
+        b.savedAt = r.savedAt;
+        return true;
+    }
+
+    // Per-key values from firmware before the blob existed
+    void _loadLegacy() {
+        Preferences p;
+        p.begin("catode_env", true);
+        EnvironmentCtx& e = _ctx->environment;
+        e.time_of_day = p.getInt("time",    12);
+        e.season      = p.getInt("season",   0);
+        e.moon_phase  = p.getInt("moon",     4);
+        e.weather     = p.getInt("weather",  0);
+        p.end();
+
+        p.begin("catode_pet", true);
+        for (const LegacyStat& s : LEGACY_STATS)
+            _ctx->stats[(int)s.id] = p.getFloat(statName(s.id), s.initial);
+        _ctx->savedAt = p.getUInt("saved_at", 0);
+        p.end();
+    }
+};
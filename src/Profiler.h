@@ -0,0 +1,187 @@
+#pragma once
+// Profiler.h - Per-frame zone timing from the CPU cycle counter
+//
+// A ProfileScope adds the cycles between its construction and destruction to
+// a named zone; a zone may be entered several times per frame.  endFrame()
+// stores the frame's totals (in us) in a rolling window for min/avg/max, and
+// optionally streams them over Serial as binary packets (tools/profdecode.py
+// turns a capture into a summary).  Zones nest by parent for the summary:
+// a parent's time includes its children.
+//
+// Stream packets start with 0xA5 0x5A and a type byte, and end with an XOR
+// of the payload bytes:
+//   'N' count, then per zone: parent (0xFF = none), name length, name
+//   'F' count, frame number (u32), then per zone: us (u32)
+// Multi-byte values are little-endian.  'N' is repeated periodically so a
+// capture can start at any point.
+
+#include <Arduino.h>
+#include "config.h"
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+enum class ProfZone : uint8_t {
+    Input, SceneUpdate, BehaviorUpdate, SceneDraw,
+    EnvironmentDraw, CharacterDraw, StatusBar, Push,
+    Count
+};
+static const int PROF_ZONE_COUNT = (int)ProfZone::Count;
+
+struct ProfZoneInfo {
+    const char* name;
+    int8_t      parent;   // index of the enclosing zone, -1 for top level
+};
+
+static const ProfZoneInfo PROF_ZONES[PROF_ZONE_COUNT] = {
+    { "input",       -1 },
+    { "update",      -1 },
+    { "behavior",     1 },
+    { "draw",        -1 },
+    { "environment",  3 },
+    { "character",    3 },
+    { "statusbar",    3 },
+    { "push",        -1 },
+};
+
+// ── Clock ──────────────────────────────────────────────────────────────────
+
+static inline uint32_t profTicks() {
+#ifdef ARDUINO
+    return ESP.getCycleCount();
+#else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static inline uint32_t profTicksPerUs() {
+#ifdef ARDUINO
+    return getCpuFrequencyMhz();
+#else
+    return 1000;
+#endif
+}
+
+// ── Profiler ───────────────────────────────────────────────────────────────
+
+struct ProfSummary {
+    uint32_t minUs = 0, avgUs = 0, maxUs = 0;
+};
+
+class Profiler {
+public:
+    Profiler() : _pos(0), _filled(0), _frame(0), _lastEnd(0), _overlay(false) {
+        memset(_cur, 0, sizeof(_cur));
+    }
+
+    void add(ProfZone z, uint32_t ticks) { _cur[(int)z] += ticks; }
+
+    // Close the frame: roll the window and stream it if enabled
+    void endFrame() {
+        uint32_t perUs = profTicksPerUs();
+        uint32_t now   = profTicks();
+        for (int z = 0; z < PROF_ZONE_COUNT; z++) {
+            _hist[_pos][z] = _cur[z] / perUs;
+            _cur[z] = 0;
+        }
+        _interval[_pos] = _lastEnd ? (now - _lastEnd) / perUs : 0;
+        _lastEnd = now;
+        _pos = (_pos + 1) % PROFILER_WINDOW;
+        if (_filled < PROFILER_WINDOW) _filled++;
+
+        if (PROFILER_STREAM) {
+            if (_frame % 60 == 0) _sendNames();
+            _sendFrame(_hist[(_pos + PROFILER_WINDOW - 1) % PROFILER_WINDOW]);
+        }
+        _frame++;
+    }
+
+    ProfSummary summary(ProfZone z) const {
+        ProfSummary s;
+        if (!_filled) return s;
+        uint64_t sum = 0;
+        s.minUs = 0xFFFFFFFF;
+        for (int i = 0; i < _filled; i++) {
+            uint32_t v = _hist[i][(int)z];
+            sum += v;
+            s.minUs = min(s.minUs, v);
+            s.maxUs = max(s.maxUs, v);
+        }
+        s.avgUs = (uint32_t)(sum / _filled);
+        return s;
+    }
+
+    // Frames per second over the window, idle time included
+    float fps() const {
+        uint64_t sum = 0;
+        int n = 0;
+        for (int i = 0; i < _filled; i++) if (_interval[i]) { sum += _interval[i]; n++; }
+        return sum ? 1e6f * n / sum : 0.0f;
+    }
+
+    bool overlay() const     { return _overlay; }
+    void setOverlay(bool on) { _overlay = on; }
+
+private:
+    uint32_t _cur[PROF_ZONE_COUNT];                     // ticks, current frame
+    uint32_t _hist[PROFILER_WINDOW][PROF_ZONE_COUNT];   // us per finished frame
+    uint32_t _interval[PROFILER_WINDOW];                // us between endFrame()s
+    int      _pos, _filled;
+    uint32_t _frame;
+    uint32_t _lastEnd;
+    bool     _overlay;
+
+    static void _send(uint8_t type, const uint8_t* payload, int n) {
+        uint8_t head[3] = { 0xA5, 0x5A, type };
+        uint8_t x = 0;
+        for (int i = 0; i < n; i++) x ^= payload[i];
+        Serial.write(head, 3);
+        Serial.write(payload, n);
+        Serial.write(x);
+    }
+
+    void _sendNames() {
+        uint8_t buf[1 + PROF_ZONE_COUNT * 18];
+        int n = 0;
+        buf[n++] = PROF_ZONE_COUNT;
+        for (int z = 0; z < PROF_ZONE_COUNT; z++) {
+            int len = min((int)strlen(PROF_ZONES[z].name), 16);
+            buf[n++] = (uint8_t)PROF_ZONES[z].parent;
+            buf[n++] = (uint8_t)len;
+            memcpy(buf + n, PROF_ZONES[z].name, len);
+            n += len;
+        }
+        _send('N', buf, n);
+    }
+
+    void _sendFrame(const uint32_t* us) {
+        uint8_t buf[1 + 4 + PROF_ZONE_COUNT * 4];
+        int n = 0;
+        buf[n++] = PROF_ZONE_COUNT;
+        for (int b = 0; b < 4; b++) buf[n++] = (uint8_t)(_frame >> (8 * b));
+        for (int z = 0; z < PROF_ZONE_COUNT; z++)
+            for (int b = 0; b < 4; b++) buf[n++] = (uint8_t)(us[z] >> (8 * b));
+        _send('F', buf, n);
+    }
+};
+
+static inline Profiler& profiler() {
+    static Profiler p;
+    return p;
+}
+
+// Times the enclosing block into a zone
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfZone z) : _zone(z), _start(PROFILER_ENABLED ? profTicks() : 0) {}
+    ~ProfileScope() { if (PROFILER_ENABLED) profiler().add(_zone, profTicks() - _start); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfZone _zone;
+    uint32_t _start;
+};
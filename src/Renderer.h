@@ -3,6 +3,12 @@
 
 #include <M5Unified.h>
 #include "config.h"
+#include "Blitter.h"
+#include "SpriteCache.h"
+#include "DirtyRegion.h"
+#include "TileDiff.h"
+#include "DrawList.h"
+#include "Profiler.h"
 
 // ============================================================================
 // Sprite data structures
@@ -55,35 +61,201 @@ struct Sprite {
 // Renderer
 // ============================================================================
 
+// What retained mode did with the last frame's commands
+struct RetainedStats {
+    int recorded = 0;
+    int culled   = 0;   // offscreen or hidden under a later opaque fill
+    int merged   = 0;   // fills folded into an adjacent same-color fill
+};
+
+// What the last show() sent to the panel
+struct PushStats {
+    uint32_t bytes  = 0;
+    int      rects  = 0;
+    uint32_t waitUs = 0;   // blocked on the previous frame's DMA transfer
+    uint32_t pushUs = 0;   // diff, copy and push setup after the wait
+};
+
 class Renderer {
 public:
-    Renderer() : _canvas(nullptr) {}
+    Renderer() : _canvas(nullptr), _spriteCache(SPRITE_CACHE_BYTES),
+                 _prevFrame(nullptr), _prevValid(false), _frameDiff(false),
+                 _tileDiff(false), _front(nullptr), _inFlight(false), _rec(nullptr),
+                 _retained(nullptr), _retainedShown(false) {}
 
     void begin() {
         M5.Display.setRotation(3);
         M5.Display.setBrightness(100);
         _canvas = new M5Canvas(&M5.Display);
         _canvas->createSprite(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+        if (USE_ASYNC_PUSH) _beginAsync();
+        setTileDiff(USE_TILE_DIFF);
         clear();
         show();
+        setRetained(USE_RETAINED_DRAW);
     }
 
     void clear(uint16_t color = COLOR_BLACK) {
-        if (_canvas) _canvas->fillScreen(color);
+        if (_rec)         _record(DrawOp::Clear, color, false);
+        else if (_canvas) { _canvas->fillScreen(color); _dirty.markAll(); }
         else         M5.Display.fillScreen(color);
     }
 
+    // Push the regions touched since the last show(). With tile or frame
+    // diff on, those regions are first narrowed to what actually changed.
+    //
+    // With async push the changed regions are copied into a front buffer and
+    // sent by DMA; show() returns while the transfer runs, and the next show()
+    // waits for it before touching the front buffer again.
     void show() {
-        if (_canvas) _canvas->pushSprite(0, 0);
+        if (!_canvas) return;
+        if (_retained && !_retainedShown) { _executeRetained(); _retainedShown = true; }
+        _lastPush = PushStats();
+        uint32_t t0 = micros();
+        waitForPush();
+        uint32_t t1 = micros();
+        _lastPush.waitUs = t1 - t0;
+
+        uint16_t* prev   = _front ? (uint16_t*)_front->getBuffer() : _prevFrame;
+        bool      copied = false;
+        if (_tileDiff) {
+            _tiles.diff((const uint16_t*)_canvas->getBuffer(), _dirty);
+        } else if (_frameDiff && prev) {
+            _diffAgainstPrevious(prev);
+            copied = true;
+        }
+
+        if (_front) {
+            if (!copied) _copyDirtyTo(prev);
+            _pushBandsDMA(prev);
+        } else if (_dirty.full()) {
+            _canvas->pushSprite(0, 0);
+            _lastPush.bytes = DISPLAY_WIDTH * DISPLAY_HEIGHT * 2;
+            _lastPush.rects = 1;
+        } else {
+            for (int i = 0; i < _dirty.count(); i++) _pushRect(_dirty.rect(i));
+        }
+        _dirty.reset();
+        _lastPush.pushUs = micros() - t1;
+    }
+
+    // Block until the last async push has finished (no-op otherwise).
+    // Call before driving the panel directly, e.g. before sleep.
+    void waitForPush() {
+        if (!_inFlight) return;
+        M5.Display.waitDMA();
+        M5.Display.endWrite();
+        _inFlight = false;
+    }
+    bool asyncPush() const { return _front != nullptr; }
+
+    // Opt-in for scenes that repaint the whole screen every frame: keep a
+    // copy of the last pushed frame and only send what differs from it.
+    // With async push the front buffer already is that copy.
+    void setFrameDiff(bool on) {
+        if (_rec) { _record(DrawOp::FrameDiff, 0, on); return; }
+        if (on == _frameDiff) return;
+        _frameDiff = on;
+        _prevValid = false;
+        if (on && !_front) {
+            _prevFrame = (uint16_t*)malloc(DISPLAY_WIDTH * DISPLAY_HEIGHT * 2);
+        } else if (!on && _prevFrame) {
+            free(_prevFrame);
+            _prevFrame = nullptr;
+        }
+    }
+    bool frameDiff() const { return _frameDiff; }
+
+    // Screen-wide alternative to frame diff; takes precedence when on
+    void setTileDiff(bool on) {
+        if (on && !_tileDiff) _tiles.invalidate();
+        _tileDiff = on;
+    }
+    bool tileDiff() const { return _tileDiff; }
+    const TileDiffStats& tileDiffStats() const { return _tiles.stats(); }
+    void resetTileDiffCounters() { _tiles.resetCounters(); }
+
+    const PushStats& lastPush() const { return _lastPush; }
+
+    // The frame being drawn, byte-swapped RGB565; what a full push would send
+    const uint16_t* backBuffer() const { return _canvas ? (const uint16_t*)_canvas->getBuffer() : nullptr; }
+
+    // Mark a region as needing a push (for drawing done outside Renderer)
+    void markDirty(int x, int y, int w, int h) { _dirty.add(x, y, w, h); }
+
+    // ── Draw lists ───────────────────────────────────────────────────────
+    // While recording, primitives (and setFrameDiff) append to the list
+    // instead of drawing; pass nullptr to stop. Used by the render pipeline,
+    // where a canvas-less Renderer records and the display Renderer replays.
+    void recordInto(DrawList* list) { _rec = list; }
+    bool recording() const { return _rec != nullptr; }
+
+    // Retained mode: the Renderer records into its own list and show()
+    // executes the frame in one batch, after culling commands that are
+    // offscreen or covered by a later opaque fill (e.g. a full-screen menu
+    // panel) and merging adjacent same-color fills. Draw order is kept, since
+    // overlapping commands have to paint in sequence.
+    void setRetained(bool on) {
+        if (on == (_retained != nullptr)) return;
+        if (on) {
+            _retained = new DrawList();
+            _retainedShown = false;
+            _rec = _retained;
+        } else {
+            if (!_retainedShown) _executeRetained();
+            _rec = nullptr;
+            delete _retained;
+            _retained = nullptr;
+        }
+    }
+    bool retained() const { return _retained != nullptr; }
+    const RetainedStats& retainedStats() const { return _retainedStats; }
+
+    // The last shown frame's commands as executed (culled and merged),
+    // valid until the next draw call; serialize() it for golden images
+    const DrawList* retainedFrame() const { return _retainedShown ? _retained : nullptr; }
+
+    void replay(const DrawList& list) {
+        for (int i = 0; i < list.count(); i++) {
+            const DrawCmd& c = list.cmd(i);
+            const int16_t* v = c.v;
+            bool filled = (c.flags & DRAW_FILLED) != 0;
+            bool mirror = (c.flags & DRAW_MIRROR) != 0;
+            switch (c.op) {
+                case DrawOp::Clear:     clear(c.fg); break;
+                case DrawOp::Rect:      drawRect(v[0], v[1], v[2], v[3], c.fg, filled); break;
+                case DrawOp::Line:      drawLine(v[0], v[1], v[2], v[3], c.fg); break;
+                case DrawOp::Pixel:     drawPixel(v[0], v[1], c.fg); break;
+                case DrawOp::Circle:    drawCircle(v[0], v[1], v[2], c.fg, filled); break;
+                case DrawOp::Triangle:  drawTriangle(v[0], v[1], v[2], v[3], v[4], v[5], c.fg, filled); break;
+                case DrawOp::Text:      drawText(list.text(c), v[0], v[1], c.fg, c.bg, c.size); break;
+                case DrawOp::Bitmap:
+                    drawBitmap1bit((const uint8_t*)c.data, v[2], v[3], v[0], v[1], c.fg, c.bg,
+                                   (c.flags & DRAW_TRANSPARENT) != 0, c.size, mirror);
+                    break;
+                case DrawOp::Sprite:
+                    drawSpriteObj((const Sprite*)c.data, v[0], v[1], c.arg, mirror, c.fg, c.bg, c.size);
+                    break;
+                case DrawOp::FrameDiff: setFrameDiff(filled); break;
+            }
+        }
     }
 
     // ── Primitives ───────────────────────────────────────────────────────
     void drawText(const char* text, int x, int y,
                   uint16_t fg = COLOR_WHITE, uint16_t bg = COLOR_BLACK,
                   int textSize = 1) {
+        if (_rec) {
+            _prepareRecord((int)strlen(text) + 1);
+            if (DrawCmd* c = _rec->addText(text)) {
+                c->v[0] = x; c->v[1] = y; c->fg = fg; c->bg = bg; c->size = textSize;
+            }
+            return;
+        }
         if (_canvas) {
             _canvas->setTextColor(fg, bg); _canvas->setTextSize(textSize);
             _canvas->setCursor(x, y); _canvas->print(text);
+            _dirty.add(x, y, (int)strlen(text) * 6 * textSize, 8 * textSize);
         } else {
             M5.Display.setTextColor(fg, bg); M5.Display.setTextSize(textSize);
             M5.Display.setCursor(x, y); M5.Display.print(text);
@@ -101,28 +273,37 @@ public:
 
     void drawRect(int x, int y, int w, int h,
                   uint16_t color = COLOR_WHITE, bool filled = false) {
-        if (_canvas) { if (filled) _canvas->fillRect(x,y,w,h,color); else _canvas->drawRect(x,y,w,h,color); }
+        if (_rec)    { _record(DrawOp::Rect, color, filled, x, y, w, h); return; }
+        if (_canvas) { if (filled) _canvas->fillRect(x,y,w,h,color); else _canvas->drawRect(x,y,w,h,color); _dirty.add(x,y,w,h); }
         else         { if (filled) M5.Display.fillRect(x,y,w,h,color); else M5.Display.drawRect(x,y,w,h,color); }
     }
 
     void drawLine(int x1, int y1, int x2, int y2, uint16_t color = COLOR_WHITE) {
-        if (_canvas) _canvas->drawLine(x1,y1,x2,y2,color);
+        if (_rec)    { _record(DrawOp::Line, color, false, x1, y1, x2, y2); return; }
+        if (_canvas) { _canvas->drawLine(x1,y1,x2,y2,color); _dirty.add(min(x1,x2), min(y1,y2), abs(x2-x1)+1, abs(y2-y1)+1); }
         else         M5.Display.drawLine(x1,y1,x2,y2,color);
     }
 
     void drawPixel(int x, int y, uint16_t color = COLOR_WHITE) {
-        if (_canvas) _canvas->drawPixel(x,y,color);
+        if (_rec)    { _record(DrawOp::Pixel, color, false, x, y); return; }
+        if (_canvas) { _canvas->drawPixel(x,y,color); _dirty.add(x,y,1,1); }
         else         M5.Display.drawPixel(x,y,color);
     }
 
     void drawCircle(int x, int y, int r, uint16_t color, bool filled = false) {
-        if (_canvas) { if (filled) _canvas->fillCircle(x,y,r,color); else _canvas->drawCircle(x,y,r,color); }
+        if (_rec)    { _record(DrawOp::Circle, color, filled, x, y, r); return; }
+        if (_canvas) { if (filled) _canvas->fillCircle(x,y,r,color); else _canvas->drawCircle(x,y,r,color); _dirty.add(x-r, y-r, 2*r+1, 2*r+1); }
         else         { if (filled) M5.Display.fillCircle(x,y,r,color); else M5.Display.drawCircle(x,y,r,color); }
     }
 
     void drawTriangle(int x0,int y0,int x1,int y1,int x2,int y2,
                       uint16_t color, bool filled = false) {
-        if (_canvas) { if (filled) _canvas->fillTriangle(x0,y0,x1,y1,x2,y2,color); else _canvas->drawTriangle(x0,y0,x1,y1,x2,y2,color); }
+        if (_rec)    { _record(DrawOp::Triangle, color, filled, x0, y0, x1, y1, x2, y2); return; }
+        if (_canvas) {
+            if (filled) _canvas->fillTriangle(x0,y0,x1,y1,x2,y2,color); else _canvas->drawTriangle(x0,y0,x1,y1,x2,y2,color);
+            int lx = min(x0, min(x1, x2)), ty = min(y0, min(y1, y2));
+            _dirty.add(lx, ty, max(x0, max(x1, x2)) - lx + 1, max(y0, max(y1, y2)) - ty + 1);
+        }
         else         { if (filled) M5.Display.fillTriangle(x0,y0,x1,y1,x2,y2,color); else M5.Display.drawTriangle(x0,y0,x1,y1,x2,y2,color); }
     }
 
@@ -134,6 +315,20 @@ public:
                         bool     transparent = true,
                         int      scale       = 1,
                         bool     mirror_h    = false) {
+        if (_rec) {
+            if (DrawCmd* c = _record(DrawOp::Bitmap, fgColor, false, x, y, srcW, srcH)) {
+                c->bg = bgColor; c->size = scale; c->data = data;
+                c->flags |= (transparent ? DRAW_TRANSPARENT : 0) | (mirror_h ? DRAW_MIRROR : 0);
+            }
+            return;
+        }
+        if (_canvas) {
+            BlitTarget t{ (uint16_t*)_canvas->getBuffer(), _canvas->width(), _canvas->height() };
+            blit1bit(t, data, srcW, srcH, x, y, fgColor, bgColor, transparent, scale, mirror_h);
+            _dirty.add(x, y, srcW * scale, srcH * scale);
+            return;
+        }
+        // No canvas: per-pixel path straight to the display
         int stride = (srcW + 7) / 8;
         for (int row = 0; row < srcH; row++) {
             for (int col = 0; col < srcW; col++) {
@@ -162,8 +357,28 @@ public:
                        uint16_t fillColor  = COLOR_CREAM,
                        int      scale      = SPRITE_SCALE) {
         if (!s) return;
+        if (_rec) {
+            if (DrawCmd* c = _record(DrawOp::Sprite, fgColor, false, x, y)) {
+                c->bg = fillColor; c->size = scale; c->arg = frame; c->data = s;
+                if (mirror_h) c->flags |= DRAW_MIRROR;
+            }
+            return;
+        }
         int f = (s->frame_count > 0) ? (frame % s->frame_count) : 0;
 
+        // Cached composite of both layers
+        if (_canvas && _spriteCache.enabled()) {
+            const uint8_t* outline = (s->frame_count > 0 && s->frames[0] != nullptr) ? s->frames[f] : nullptr;
+            const uint8_t* fill    = (s->fill_frame_count > 0 && s->fill_frames[0] != nullptr)
+                                   ? s->fill_frames[frame % s->fill_frame_count] : nullptr;
+            BlitTarget t{ (uint16_t*)_canvas->getBuffer(), _canvas->width(), _canvas->height() };
+            SpriteCacheKey key{ s, frame, mirror_h, scale, fgColor, fillColor };
+            if (_spriteCache.draw(t, x, y, key, outline, fill, s->width, s->height)) {
+                _dirty.add(x, y, s->width * scale, s->height * scale);
+                return;
+            }
+        }
+
         // Draw fill first (white pixels = shape fill, black = transparent)
         if (s->fill_frame_count > 0 && s->fill_frames[0] != nullptr) {
             int ff = frame % s->fill_frame_count;
@@ -185,8 +400,25 @@ public:
         }
     }
 
+    // ── Pre-rendered images ──────────────────────────────────────────────
+    // Blits go straight into the canvas, so there has to be one, and not
+    // while recording
+    bool canBlit() const { return _canvas && !_rec; }
+
+    // Copy the opaque pixels of columns [srcX, srcX + w) of src to (x, y)
+    void drawRuns(const RunImage& src, int srcX, int x, int y, int w) {
+        if (!canBlit()) return;
+        BlitTarget t{ (uint16_t*)_canvas->getBuffer(), _canvas->width(), _canvas->height() };
+        blitRuns(t, src, srcX, x, y, w);
+        _dirty.add(x, y, w, src.height);
+    }
+
+    SpriteCache&       spriteCache()       { return _spriteCache; }
+    const SpriteCache& spriteCache() const { return _spriteCache; }
+
     // ── Status bar ───────────────────────────────────────────────────────
     void drawStatusBar(float fullness, float energy, float mood) {
+        ProfileScope prof(ProfZone::StatusBar);
         // Black background strip
         drawRect(0, 0, DISPLAY_WIDTH, STATUS_BAR_HEIGHT, COLOR_UI_BG, true);
         drawLine(0, STATUS_BAR_HEIGHT - 1, DISPLAY_WIDTH, STATUS_BAR_HEIGHT - 1, COLOR_UI_BORDER);
@@ -216,8 +448,240 @@ public:
         drawText(buf, DISPLAY_WIDTH - 16, 0, COLOR_MED_GRAY, COLOR_BLACK, 1);
     }
 
+    // ── Profiler overlay ─────────────────────────────────────────────────
+    // avg/max us per zone over the profiler window, children indented
+    void drawProfiler(const Profiler& p) {
+        const int w = 118, h = PROF_ZONE_COUNT * 8 + 14;
+        const int x = DISPLAY_WIDTH - w, y = STATUS_BAR_HEIGHT;
+        drawRect(x, y, w, h, COLOR_UI_BG, true);
+        drawRect(x, y, w, h, COLOR_UI_BORDER, false);
+        drawText("zone   avg/max us", x + 3, y + 3, COLOR_UI_DIM, COLOR_UI_BG, 1);
+        for (int z = 0; z < PROF_ZONE_COUNT; z++) {
+            ProfSummary s = p.summary((ProfZone)z);
+            drawTextf(x + 3, y + 12 + z * 8, COLOR_WHITE, COLOR_UI_BG, 1, "%s%-8.8s%4lu/%-4lu",
+                      PROF_ZONES[z].parent >= 0 ? " " : "", PROF_ZONES[z].name,
+                      (unsigned long)s.avgUs, (unsigned long)s.maxUs);
+        }
+        drawFps(p.fps());
+    }
+
 private:
-    M5Canvas* _canvas;
+    M5Canvas*   _canvas;
+    SpriteCache _spriteCache;
+    DirtyRegion _dirty;
+    PushStats   _lastPush;
+    uint16_t*   _prevFrame;   // last pushed frame (frame diff, sync push only)
+    bool        _prevValid;
+    bool        _frameDiff;
+    TileDiff    _tiles;
+    bool        _tileDiff;
+    M5Canvas*   _front;       // DMA source while the next frame is drawn
+    bool        _inFlight;
+    DrawList*   _rec;         // recording target, if any
+    DrawList*   _retained;    // own list in retained mode (== _rec)
+    bool        _retainedShown;
+    RetainedStats _retainedStats;
+
+    // Retained mode: start a new frame after show(), or run what we have
+    // so far when the list is out of room
+    void _prepareRecord(int textBytes = 0) {
+        if (!_retained || _rec != _retained) return;
+        if (_retainedShown) {
+            _retained->reset();
+            _retainedShown = false;
+        } else if (_retained->full(textBytes)) {
+            _executeRetained();
+            _retained->reset();
+        }
+    }
+
+    void _executeRetained() {
+        _rec = nullptr;
+        _retainedStats = RetainedStats();
+        _retainedStats.recorded = _retained->count();
+        _optimize(*_retained);
+        replay(*_retained);
+        _rec = _retained;
+    }
+
+    // Screen-clipped bounds of what a command can touch (w <= 0: nothing)
+    DirtyRect _cmdBounds(const DrawList& l, const DrawCmd& c) const {
+        const int16_t* v = c.v;
+        DirtyRect b = { 0, 0, 0, 0 };
+        switch (c.op) {
+            case DrawOp::Clear:     b = { 0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT }; break;
+            case DrawOp::Rect:      b = { v[0], v[1], v[2], v[3] }; break;
+            case DrawOp::Line:      b = { min(v[0], v[2]), min(v[1], v[3]),
+                                          abs(v[2] - v[0]) + 1, abs(v[3] - v[1]) + 1 }; break;
+            case DrawOp::Pixel:     b = { v[0], v[1], 1, 1 }; break;
+            case DrawOp::Circle:    b = { v[0] - v[2], v[1] - v[2], 2 * v[2] + 1, 2 * v[2] + 1 }; break;
+            case DrawOp::Triangle: {
+                int x0 = min((int)v[0], min((int)v[2], (int)v[4])), x1 = max((int)v[0], max((int)v[2], (int)v[4]));
+                int y0 = min((int)v[1], min((int)v[3], (int)v[5])), y1 = max((int)v[1], max((int)v[3], (int)v[5]));
+                b = { x0, y0, x1 - x0 + 1, y1 - y0 + 1 };
+                break;
+            }
+            case DrawOp::Text:      b = { v[0], v[1], (int)strlen(l.text(c)) * 6 * c.size, 8 * c.size }; break;
+            case DrawOp::Bitmap:    b = { v[0], v[1], v[2] * c.size, v[3] * c.size }; break;
+            case DrawOp::Sprite: {
+                const Sprite* s = (const Sprite*)c.data;
+                b = { v[0], v[1], s->width * c.size, s->height * c.size };
+                break;
+            }
+            case DrawOp::FrameDiff: break;
+        }
+        int x1 = min(b.right(), DISPLAY_WIDTH), y1 = min(b.bottom(), DISPLAY_HEIGHT);
+        b.x = max(b.x, 0); b.y = max(b.y, 0);
+        b.w = x1 - b.x;    b.h = y1 - b.y;
+        return b;
+    }
+
+    static bool _contains(const DirtyRect& o, const DirtyRect& r) {
+        return o.x <= r.x && o.y <= r.y && o.right() >= r.right() && o.bottom() >= r.bottom();
+    }
+
+    // Two same-color fills whose union is exactly a rectangle
+    static bool _mergeFills(DrawCmd& a, const DrawCmd& b) {
+        if (a.op != DrawOp::Rect || b.op != DrawOp::Rect || a.fg != b.fg
+            || !(a.flags & DRAW_FILLED) || !(b.flags & DRAW_FILLED)) return false;
+        int16_t* r = a.v;
+        const int16_t* s = b.v;
+        if (r[0] == s[0] && r[2] == s[2] && s[1] <= r[1] + r[3] && r[1] <= s[1] + s[3]) {
+            int y0 = min(r[1], s[1]), y1 = max(r[1] + r[3], s[1] + s[3]);
+            r[1] = y0; r[3] = y1 - y0;
+            return true;
+        }
+        if (r[1] == s[1] && r[3] == s[3] && s[0] <= r[0] + r[2] && r[0] <= s[0] + s[2]) {
+            int x0 = min(r[0], s[0]), x1 = max(r[0] + r[2], s[0] + s[2]);
+            r[0] = x0; r[2] = x1 - x0;
+            return true;
+        }
+        return false;
+    }
+
+    void _optimize(DrawList& l) {
+        // Back to front: drop what a later opaque fill fully covers
+        static const int MAX_OCCLUDERS = 8;
+        DirtyRect occ[MAX_OCCLUDERS];
+        int  nOcc = 0;
+        bool keep[DRAW_LIST_MAX_CMDS];
+        for (int i = l.count() - 1; i >= 0; i--) {
+            const DrawCmd& c = l.cmd(i);
+            keep[i] = true;
+            if (c.op == DrawOp::FrameDiff) continue;
+            DirtyRect b = _cmdBounds(l, c);
+            bool hidden = b.w <= 0 || b.h <= 0;
+            for (int k = 0; k < nOcc && !hidden; k++) hidden = _contains(occ[k], b);
+            if (hidden) { keep[i] = false; _retainedStats.culled++; continue; }
+
+            bool opaque = c.op == DrawOp::Clear || (c.op == DrawOp::Rect && (c.flags & DRAW_FILLED));
+            if (!opaque) continue;
+            if (nOcc < MAX_OCCLUDERS) { occ[nOcc++] = b; continue; }
+            int smallest = 0;
+            for (int k = 1; k < nOcc; k++) if (occ[k].area() < occ[smallest].area()) smallest = k;
+            if (b.area() > occ[smallest].area()) occ[smallest] = b;
+        }
+
+        // Compact in order, folding each fill into the previous kept one
+        int n = 0;
+        for (int i = 0; i < l.count(); i++) {
+            if (!keep[i]) continue;
+            if (n > 0 && _mergeFills(l.cmd(n - 1), l.cmd(i))) { _retainedStats.merged++; continue; }
+            l.cmd(n++) = l.cmd(i);
+        }
+        l.truncate(n);
+    }
+
+    DrawCmd* _record(DrawOp op, uint16_t color, bool filled,
+                     int a = 0, int b = 0, int c = 0, int d = 0, int e = 0, int f = 0) {
+        _prepareRecord();
+        DrawCmd* cmd = _rec->add(op);
+        if (!cmd) return nullptr;
+        cmd->fg    = color;
+        cmd->flags = filled ? DRAW_FILLED : 0;
+        cmd->v[0] = a; cmd->v[1] = b; cmd->v[2] = c;
+        cmd->v[3] = d; cmd->v[4] = e; cmd->v[5] = f;
+        return cmd;
+    }
+
+    void _beginAsync() {
+        _front = new M5Canvas(&M5.Display);
+        if (!_front->createSprite(DISPLAY_WIDTH, DISPLAY_HEIGHT)) {
+            delete _front;   // not enough DMA-capable RAM: stay synchronous
+            _front = nullptr;
+            return;
+        }
+        M5.Display.initDMA();
+    }
+
+    void _copyDirtyTo(uint16_t* dst) {
+        const uint16_t* src = (const uint16_t*)_canvas->getBuffer();
+        for (int i = 0; i < _dirty.count(); i++) {
+            const DirtyRect& r = _dirty.rect(i);
+            for (int y = r.y; y < r.bottom(); y++) {
+                int off = y * DISPLAY_WIDTH + r.x;
+                memcpy(dst + off, src + off, r.w * 2);
+            }
+        }
+    }
+
+    // DMA needs contiguous source memory, so dirty rects are widened to
+    // full-width row bands; overlapping bands are merged.
+    void _pushBandsDMA(const uint16_t* src) {
+        int y0[DIRTY_MAX_RECTS], y1[DIRTY_MAX_RECTS], n = 0;
+        for (int i = 0; i < _dirty.count(); i++) {
+            const DirtyRect& r = _dirty.rect(i);
+            int j = n++;
+            while (j > 0 && y0[j - 1] > r.y) { y0[j] = y0[j - 1]; y1[j] = y1[j - 1]; j--; }
+            y0[j] = r.y; y1[j] = r.bottom();
+        }
+        int i = 0;
+        while (i < n) {
+            int top = y0[i], bottom = y1[i];
+            for (i++; i < n && y0[i] <= bottom; i++) bottom = max(bottom, y1[i]);
+            if (!_inFlight) { M5.Display.startWrite(); _inFlight = true; }
+            M5.Display.pushImageDMA(0, top, DISPLAY_WIDTH, bottom - top,
+                                    (const lgfx::swap565_t*)(src + top * DISPLAY_WIDTH));
+            _lastPush.bytes += DISPLAY_WIDTH * (bottom - top) * 2;
+            _lastPush.rects++;
+        }
+    }
+
+    void _pushRect(const DirtyRect& r) {
+        M5.Display.setClipRect(r.x, r.y, r.w, r.h);
+        _canvas->pushSprite(0, 0);
+        M5.Display.clearClipRect();
+        _lastPush.bytes += r.area() * 2;
+        _lastPush.rects++;
+    }
+
+    // Replace the dirty region with row spans that differ from the last
+    // pushed frame, updating the copy as we go.
+    void _diffAgainstPrevious(uint16_t* prev) {
+        const uint16_t* cur = (const uint16_t*)_canvas->getBuffer();
+        if (!_prevValid) {
+            memcpy(prev, cur, DISPLAY_WIDTH * DISPLAY_HEIGHT * 2);
+            _prevValid = true;
+            _dirty.markAll();
+            return;
+        }
+
+        DirtyRegion changed;
+        for (int i = 0; i < _dirty.count(); i++) {
+            const DirtyRect& r = _dirty.rect(i);
+            for (int y = r.y; y < r.bottom(); y++) {
+                const uint16_t* a = cur        + y * DISPLAY_WIDTH + r.x;
+                uint16_t*       b = prev       + y * DISPLAY_WIDTH + r.x;
+                if (memcmp(a, b, r.w * 2) == 0) continue;
+                int x0 = 0, x1 = r.w;
+                while (a[x0] == b[x0])         x0++;
+                while (a[x1 - 1] == b[x1 - 1]) x1--;
+                memcpy(b + x0, a + x0, (x1 - x0) * 2);
+                changed.add(r.x + x0, y, x1 - x0, 1);
+            }
+        }
+        _dirty = changed;
+    }
 
     void _drawMiniBar(int x, int y, int w, int h, float pct, const char* label) {
         uint16_t color = (pct > 0.6f) ? COLOR_BAR_HIGH
@@ -13,6 +13,8 @@
 //   update() - called every frame
 //   draw()   - called every frame after update
 //   handleInput() - called every frame before update
+//   diffFrames()  - true if draw() repaints the whole screen; the renderer
+//                   then pushes only pixels that changed since last frame
 
 // Return type from update/handleInput: signal a scene change
 struct SceneResult {
@@ -37,6 +39,7 @@ public:
     virtual SceneResult update(float dt)     { return NO_CHANGE; }
     virtual void        draw()               {}
     virtual SceneResult handleInput()        { return NO_CHANGE; }
+    virtual bool        diffFrames() const   { return false; }
 
 protected:
     GameContext*  _context;
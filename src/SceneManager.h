@@ -94,10 +94,21 @@ public:
         }
     }
 
+    // Switch to a scene by name on the next update, as if a scene had asked
+    // for it. Returns false for an unknown name.
+    bool requestScene(const char* name) {
+        SceneID id = _sceneIDFromName(name);
+        if (id == SceneID::NONE) return false;
+        _pendingID = id;
+        return true;
+    }
+    SceneID currentScene() const { return _currentID; }
+
     void draw() {
         if (_current) _current->draw();
         if (_settingsOpen) _settings.draw();
         if (_mainMenuOpen) _mainMenu.draw();
+        if (profiler().overlay()) _renderer->drawProfiler(profiler());
     }
 
 private:
@@ -142,6 +153,8 @@ private:
         _mainMenuItems[_mainMenuCount++] = { "Minigames", nullptr, ACT_NONE, nullptr, _miniSubItems, mn };
 
         _mainMenuItems[_mainMenuCount++] = { "Environment",   nullptr, ACT_CUSTOM, "settings",       nullptr,0,nullptr, nullptr, nullptr };
+        if (PROFILER_ENABLED)
+            _mainMenuItems[_mainMenuCount++] = { "Profiler",  nullptr, ACT_CUSTOM, "profiler",       nullptr,0,nullptr, nullptr, nullptr };
     }
 
     void _openMainMenu() {
@@ -157,6 +170,8 @@ private:
         } else if (strcmp(p,"settings")==0) {
             _settingsOpen = true;
             _settings.open();
+        } else if (strcmp(p,"profiler")==0) {
+            profiler().setOverlay(!profiler().overlay());
         } else {
             // Minigame name
             for (int i=0; i<MINIGAME_COUNT; i++) {
@@ -237,14 +252,15 @@ private:
             _currentID = id;
             _current->enter();
         }
+        _renderer->setFrameDiff(_current->diffFrames());
     }
 
+    // The scene evicted may be the current one: _switchTo evicts after the
+    // current scene has exited, and the destructor takes everything
     void _destroyCache(int slot) {
         if (_cache[slot].scene) {
-            if (_cache[slot].scene != _current) {
-                _cache[slot].scene->unload();
-                delete _cache[slot].scene;
-            }
+            _cache[slot].scene->unload();
+            delete _cache[slot].scene;
             _cache[slot] = { nullptr, SceneID::NONE };
         }
     }
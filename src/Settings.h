@@ -88,11 +88,9 @@ public:
             SettingsEntry& e = _entries[_cursor];
             if (_input->next()) {
                 if (e.value) *e.value = (*e.value + 1) % e.optionCount;
-                _applyChanges();
             }
             if (_input->prev()) {
                 if (e.value) *e.value = (*e.value - 1 + e.optionCount) % e.optionCount;
-                _applyChanges();
             }
             if (_input->select() || _input->back()) { _editMode = false; }
         }
@@ -123,10 +121,6 @@ private:
         _entries[_entryCount++] = { "Weather",     WEATHER_OPTS,  5, &_ctx->environment.weather     };
         _entries[_entryCount++] = { "Moon phase",  MOON_OPTS,     8, &_ctx->environment.moon_phase  };
     }
-
-    void _applyChanges() {
-        _ctx->saveEnv();
-    }
 };
 
 // Option string tables
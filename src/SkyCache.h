@@ -0,0 +1,201 @@
+#pragma once
+// SkyCache.h - The outdoor sky, with its static part drawn once per look
+//
+// Everything in the sky but the star twinkle follows from the hour, weather
+// and moon phase: the color, the sun or moon, and which stars show.
+// SkyCache draws that part into an image the first time it sees a
+// combination, along with the stars the moon left uncovered, and each frame
+// copies the image's opaque runs (the sun and moon stick out of the sky
+// band) before drawing the stars not twinkling off.  A setting changed from
+// the Settings scene is a new key on the next frame.  Recording Renderers
+// get the sky drawn directly.  Rain and snow are particles (Particles.h).
+
+#include <Arduino.h>
+#include "config.h"
+#include "Blitter.h"
+#include "Renderer.h"
+
+struct SkyKey {
+    int hour;        // 0-23
+    int weather;     // 0 clear, 1 cloudy, 2 rain, 3 storm, 4 snow
+    int moonPhase;   // 0 new .. 4 full .. 7 waning
+
+    bool operator==(const SkyKey& o) const {
+        return hour == o.hour && weather == o.weather && moonPhase == o.moonPhase;
+    }
+};
+
+static const int SKY_HEIGHT = PLAY_HEIGHT * 2 / 3;
+static const int SKY_STARS  = 14;
+static const int SKY_MARGIN = 9;   // widest sun or moon radius past the band
+static const int SKY_IMG_Y  = PLAY_Y - SKY_MARGIN;
+static const int SKY_IMG_H  = SKY_HEIGHT + 2 * SKY_MARGIN;
+
+class SkyCache {
+public:
+    SkyCache() : _img(nullptr), _rowStart(nullptr), _runs(nullptr), _runCap(0), _starCount(0), _valid(false) {}
+
+    ~SkyCache() {
+        delete _img;
+        free(_rowStart);
+    }
+
+    SkyCache(const SkyCache&) = delete;
+    SkyCache& operator=(const SkyCache&) = delete;
+
+    // Draw the sky; anim is seconds of scene time, for the twinkle
+    void draw(Renderer& r, const SkyKey& k, float anim) {
+        if (!r.canBlit() || !_ready(k)) { drawDirect(r, k, anim); return; }
+        r.drawRuns({ (const uint16_t*)_img->getBuffer(), DISPLAY_WIDTH, SKY_IMG_H, _rowStart, _runs },
+                   0, 0, SKY_IMG_Y, DISPLAY_WIDTH);
+        for (int s = 0; s < _starCount; s++)
+            if (_starOn(_stars[s].i, anim)) r.drawPixel(_stars[s].x, _stars[s].y, COLOR_WHITE);
+    }
+
+    // The same sky without the cache
+    static void drawDirect(Renderer& r, const SkyKey& k, float anim) {
+        _drawBody(r, k, [&](int i, int x, int y) {
+            if (_starOn(i, anim)) r.drawPixel(x, y, COLOR_WHITE);
+        });
+    }
+
+private:
+    static const uint16_t KEY  = 0x2000;   // not drawn; byte-swapped 0x0020
+    static const uint16_t STAR = 0x0021;   // placeholder the moon may cover
+
+    struct Star { int16_t x, y; uint8_t i; };
+
+    // Renderer-like calls onto the image, offset so it starts at SKY_IMG_Y
+    struct Pen {
+        M5Canvas* c;
+        void drawRect(int x, int y, int w, int h, uint16_t col, bool filled) {
+            if (filled) c->fillRect(x, y - SKY_IMG_Y, w, h, col);
+            else        c->drawRect(x, y - SKY_IMG_Y, w, h, col);
+        }
+        void drawCircle(int x, int y, int rad, uint16_t col, bool filled) {
+            if (filled) c->fillCircle(x, y - SKY_IMG_Y, rad, col);
+            else        c->drawCircle(x, y - SKY_IMG_Y, rad, col);
+        }
+        void drawPixel(int x, int y, uint16_t col) { c->drawPixel(x, y - SKY_IMG_Y, col); }
+    };
+
+    M5Canvas* _img;
+    uint32_t* _rowStart;   // then the runs, one allocation
+    PixelRun* _runs;
+    uint32_t  _runCap;
+    Star      _stars[SKY_STARS];
+    int       _starCount;
+    SkyKey    _key;
+    bool      _valid;
+
+    static bool _starOn(int i, float anim) { return (int)(anim * 3 + i) % 5 != 0; }
+
+    // Redraw the image if k is a new look; false if there is no image
+    bool _ready(const SkyKey& k) {
+        if (_valid && _key == k) return true;
+        if (!_img) {
+            _img = new M5Canvas();
+#ifdef BOARD_HAS_PSRAM
+            _img->setPsram(true);
+#endif
+            if (!_img->createSprite(DISPLAY_WIDTH, SKY_IMG_H)) { delete _img; _img = nullptr; return false; }
+        }
+        _key   = k;
+        _valid = false;
+
+        uint16_t* buf = (uint16_t*)_img->getBuffer();
+        for (int i = 0; i < DISPLAY_WIDTH * SKY_IMG_H; i++) buf[i] = KEY;
+        Pen pen{ _img };
+        _starCount = 0;
+        _drawBody(pen, k, [&](int i, int x, int y) {
+            pen.drawPixel(x, y, STAR);
+            _stars[_starCount++] = { (int16_t)x, (int16_t)y, (uint8_t)i };
+        });
+        // Stars the moon drew over are gone; the rest show sky when off
+        uint16_t sky = _skyColor(k);
+        int kept = 0;
+        for (int s = 0; s < _starCount; s++) {
+            uint16_t& p = buf[(_stars[s].y - SKY_IMG_Y) * DISPLAY_WIDTH + _stars[s].x];
+            if (p != swap565(STAR)) continue;
+            p = swap565(sky);
+            _stars[kept++] = _stars[s];
+        }
+        _starCount = kept;
+
+        BlitTarget img{ buf, DISPLAY_WIDTH, SKY_IMG_H };
+        uint32_t n = findRuns(img, KEY, nullptr, nullptr);
+        if (!_rowStart || n > _runCap) {
+            free(_rowStart);
+            _rowStart = (uint32_t*)malloc((SKY_IMG_H + 1) * sizeof(uint32_t) + n * sizeof(PixelRun));
+            _runCap   = n;
+            if (!_rowStart) return false;
+            _runs = (PixelRun*)(_rowStart + SKY_IMG_H + 1);
+        }
+        findRuns(img, KEY, _rowStart, _runs);
+        _valid = true;
+        return true;
+    }
+
+    static uint16_t _skyColor(const SkyKey& k) {
+        bool isNight = (k.hour < 5 || k.hour >= 21);
+        bool isDawn  = (k.hour >= 5 && k.hour <= 7);
+        bool isDusk  = (k.hour >= 18 && k.hour < 21);
+        if (k.weather >= 1) return 0x6B4D;           // overcast: flat gray
+        if (isNight)        return COLOR_SKY_NIGHT;  // deep navy
+        if (isDawn)         return 0xFD60;           // warm orange-pink
+        if (isDusk)         return 0xCA46;           // purple-orange
+        return COLOR_SKY_DAY;                        // bright blue day
+    }
+
+    // Sky band, stars (each through star(i, x, y)) and sun or moon.  P is a
+    // Renderer or a Pen.
+    template <class P, class StarFn>
+    static void _drawBody(P& p, const SkyKey& k, StarFn star) {
+        bool isNight = (k.hour < 5 || k.hour >= 21);
+        bool isDawn  = (k.hour >= 5 && k.hour <= 7);
+        bool isDusk  = (k.hour >= 18 && k.hour < 21);
+        uint16_t skyColor = _skyColor(k);
+        int skyH = SKY_HEIGHT;
+        p.drawRect(0, PLAY_Y, DISPLAY_WIDTH, skyH, skyColor, true);
+
+        if (isNight && k.weather == 0) {
+            // Stars (pseudo-random, twinkle based on anim)
+            uint32_t seed = 0xDEADBEEF;
+            for (int i = 0; i < SKY_STARS; i++) {
+                seed = seed * 1664525u + 1013904223u;
+                int sx = (int)((seed >> 16) & 0xFFFF) % (DISPLAY_WIDTH - 4) + 2;
+                seed = seed * 1664525u + 1013904223u;
+                int sy = PLAY_Y + 2 + (int)((seed >> 16) & 0xFFFF) % (skyH - 4);
+                star(i, sx, sy);
+            }
+            // Moon — shape based on moon_phase (0=new..4=full..7=waning)
+            int moonX = DISPLAY_WIDTH - 22, moonY = PLAY_Y + 10;
+            if (k.moonPhase > 0) {
+                p.drawCircle(moonX, moonY, 5, COLOR_WHITE, true);
+                if (k.moonPhase < 4) {
+                    // Waxing — shadow on left
+                    int off = (4 - k.moonPhase) * 2;
+                    p.drawCircle(moonX - off, moonY, 5, skyColor, true);
+                } else if (k.moonPhase > 4) {
+                    // Waning — shadow on right
+                    int off = (k.moonPhase - 4) * 2;
+                    p.drawCircle(moonX + off, moonY, 5, skyColor, true);
+                }
+            }
+        } else if (!isNight && k.weather < 2) {
+            // Sun arc: rises at left (6am), peaks center (12pm), sets right (18pm)
+            float t = (float)(k.hour - 6) / 12.0f;
+            t = max(0.0f, min(1.0f, t));
+            int sunX = (int)(8 + t * (DISPLAY_WIDTH - 16));
+            int sunY = PLAY_Y + skyH - 6 - (int)(sin(t * M_PI) * (skyH - 12));
+            p.drawCircle(sunX, sunY, 6, COLOR_YELLOW, true);
+            p.drawCircle(sunX, sunY, 8, COLOR_ORANGE, false);
+        } else if (isDawn || isDusk) {
+            // Glow on horizon
+            int sunY = PLAY_Y + skyH - 6;
+            int sunX = isDawn ? 20 : DISPLAY_WIDTH - 20;
+            p.drawCircle(sunX, sunY, 9, COLOR_ORANGE, true);
+            p.drawCircle(sunX, sunY, 6, COLOR_YELLOW, true);
+        }
+    }
+};
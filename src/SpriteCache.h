@@ -0,0 +1,261 @@
+#pragma once
+// SpriteCache.h - Bounded LRU cache of pre-expanded, pre-scaled sprite tiles
+//
+// Each entry holds one sprite frame with its fill and outline layers already
+// composited into byte-swapped RGB565 (the M5Canvas layout), scaled
+// horizontally, plus the opaque spans of every source row.  A hit is a span
+// memcpy per destination row; rows are repeated `scale` times on the way out.
+//
+// Entries live in one arena of the budget's size, taken on the first miss,
+// so misses and evictions don't touch the heap.  New entries go at the end
+// of the arena; when that is full, the live entries are slid down over the
+// holes evictions left.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Blitter.h"
+
+struct Sprite;
+
+static const int SPRITE_CACHE_MAX_ENTRIES = 48;
+
+struct SpriteCacheKey {
+    const Sprite* sprite;
+    int           frame;
+    bool          mirror;
+    int           scale;
+    uint16_t      fg;
+    uint16_t      fill;
+
+    bool operator==(const SpriteCacheKey& o) const {
+        return sprite == o.sprite && frame == o.frame && mirror == o.mirror
+            && scale == o.scale && fg == o.fg && fill == o.fill;
+    }
+};
+
+struct SpriteCacheStats {
+    uint32_t hits      = 0;
+    uint32_t misses    = 0;
+    uint32_t evictions = 0;
+    uint32_t bytesUsed = 0;
+    int      entries   = 0;
+};
+
+class SpriteCache {
+public:
+    explicit SpriteCache(uint32_t budgetBytes = 0)
+        : _budget(budgetBytes), _tick(0), _arena(nullptr), _used(0) {}
+    ~SpriteCache() { free(_arena); }
+
+    SpriteCache(const SpriteCache&) = delete;
+    SpriteCache& operator=(const SpriteCache&) = delete;
+
+    bool enabled() const { return _budget > 0; }
+
+    // Empties the cache; the arena is retaken at the new size on the next miss
+    void setBudget(uint32_t bytes) {
+        clear();
+        free(_arena);
+        _arena  = nullptr;
+        _budget = bytes;
+    }
+    uint32_t budget() const { return _budget; }
+
+    const SpriteCacheStats& stats() const { return _stats; }
+    void resetCounters() { _stats.hits = _stats.misses = _stats.evictions = 0; }
+
+    void clear() {
+        for (int i = 0; i < SPRITE_CACHE_MAX_ENTRIES; i++) _entries[i] = Entry();
+        _used            = 0;
+        _stats.bytesUsed = 0;
+        _stats.entries   = 0;
+    }
+
+    // Draw through the cache. Returns false if the sprite can't be cached
+    // (over budget / allocation failure) and the caller must draw it directly.
+    bool draw(const BlitTarget& t, int x, int y, const SpriteCacheKey& key,
+              const uint8_t* outline, const uint8_t* fill, int srcW, int srcH) {
+        if (!enabled() || !t.buf) return false;
+
+        Entry* e = _find(key);
+        if (e) {
+            _stats.hits++;
+        } else {
+            _stats.misses++;
+            e = _build(key, outline, fill, srcW, srcH);
+            if (!e) return false;
+        }
+        e->lastUse = ++_tick;
+        _blit(t, *e, x, y);
+        return true;
+    }
+
+private:
+    struct Entry {
+        SpriteCacheKey key;
+        uint32_t  lastUse = 0;
+        uint32_t  bytes   = 0;
+        int       w = 0, h = 0, scale = 1;  // w is scaled, h is source rows
+        uint16_t* pixels  = nullptr;        // h rows of w pixels
+        uint16_t* rowSpan = nullptr;        // h+1 offsets into spans
+        uint16_t* spans   = nullptr;        // (x0, x1) pairs, scaled x
+        uint8_t*  block   = nullptr;        // in the arena; null = free slot
+    };
+
+    Entry    _entries[SPRITE_CACHE_MAX_ENTRIES];
+    uint32_t _budget;
+    uint32_t _tick;
+    uint8_t* _arena;
+    uint32_t _used;   // arena bytes up to the end of the last entry
+    SpriteCacheStats _stats;
+
+    Entry* _find(const SpriteCacheKey& k) {
+        for (int i = 0; i < SPRITE_CACHE_MAX_ENTRIES; i++)
+            if (_entries[i].block && _entries[i].key == k) return &_entries[i];
+        return nullptr;
+    }
+
+    // Slide the live entries down to the start of the arena, in order
+    void _compact() {
+        Entry* live[SPRITE_CACHE_MAX_ENTRIES];
+        int n = 0;
+        for (int i = 0; i < SPRITE_CACHE_MAX_ENTRIES; i++) {
+            if (!_entries[i].block) continue;
+            int j = n++;
+            for (; j > 0 && live[j - 1]->block > _entries[i].block; j--) live[j] = live[j - 1];
+            live[j] = &_entries[i];
+        }
+        _used = 0;
+        for (int i = 0; i < n; i++) {
+            Entry& e = *live[i];
+            uint8_t* to = _arena + _used;
+            if (to != e.block) {
+                memmove(to, e.block, e.bytes);
+                e.pixels  = (uint16_t*)(to + ((uint8_t*)e.pixels  - e.block));
+                e.rowSpan = (uint16_t*)(to + ((uint8_t*)e.rowSpan - e.block));
+                e.spans   = (uint16_t*)(to + ((uint8_t*)e.spans   - e.block));
+                e.block   = to;
+            }
+            _used += e.bytes;
+        }
+    }
+
+    bool _evictOldest() {
+        Entry* oldest = nullptr;
+        for (int i = 0; i < SPRITE_CACHE_MAX_ENTRIES; i++) {
+            Entry& e = _entries[i];
+            if (e.block && (!oldest || e.lastUse < oldest->lastUse)) oldest = &e;
+        }
+        if (!oldest) return false;
+        _stats.bytesUsed -= oldest->bytes;
+        _stats.entries--;
+        _stats.evictions++;
+        *oldest = Entry();
+        return true;
+    }
+
+    Entry* _freeSlot() {
+        for (int i = 0; i < SPRITE_CACHE_MAX_ENTRIES; i++)
+            if (!_entries[i].block) return &_entries[i];
+        return nullptr;
+    }
+
+    static bool _bit(const uint8_t* data, int stride, int row, int col) {
+        return data && ((data[row * stride + (col >> 3)] >> (7 - (col & 7))) & 1);
+    }
+
+    Entry* _build(const SpriteCacheKey& k, const uint8_t* outline, const uint8_t* fill,
+                  int srcW, int srcH) {
+        if (srcW <= 0 || srcH <= 0 || k.scale < 1) return nullptr;
+        const int stride = (srcW + 7) / 8;
+        const int w      = srcW * k.scale;
+
+        // Count spans first so the entry is a single allocation
+        int spanCount = 0;
+        for (int r = 0; r < srcH; r++) {
+            bool prev = false;
+            for (int c = 0; c < srcW; c++) {
+                bool op = _bit(outline, stride, r, c) || _bit(fill, stride, r, c);
+                if (op && !prev) spanCount++;
+                prev = op;
+            }
+        }
+
+        // Rounded up so every entry in the arena stays 4-byte aligned
+        uint32_t bytes = ((uint32_t)w * srcH * 2 + (uint32_t)(srcH + 1) * 2 + (uint32_t)spanCount * 4 + 3) & ~3u;
+        if (bytes > _budget) return nullptr;
+        if (!_arena && !(_arena = (uint8_t*)malloc(_budget))) return nullptr;
+        while (_stats.bytesUsed + bytes > _budget && _evictOldest()) {}
+        Entry* e = _freeSlot();
+        if (!e) { _evictOldest(); e = _freeSlot(); }
+        if (!e) return nullptr;
+        if (_used + bytes > _budget) _compact();
+
+        uint8_t* block = _arena + _used;
+        _used += bytes;
+
+        e->key     = k;
+        e->bytes   = bytes;
+        e->w       = w;
+        e->h       = srcH;
+        e->scale   = k.scale;
+        e->block   = block;
+        e->pixels  = (uint16_t*)block;
+        e->rowSpan = e->pixels + w * srcH;
+        e->spans   = e->rowSpan + srcH + 1;
+
+        const uint16_t fg = swap565(k.fg);
+        const uint16_t fl = swap565(k.fill);
+        int s = 0;
+        for (int r = 0; r < srcH; r++) {
+            e->rowSpan[r] = (uint16_t)s;
+            uint16_t* px = e->pixels + r * w;
+            int runStart = -1;
+            for (int c = 0; c < srcW; c++) {
+                int sc = k.mirror ? (srcW - 1 - c) : c;
+                bool ol = _bit(outline, stride, r, sc);
+                bool fi = _bit(fill, stride, r, sc);
+                uint16_t color = ol ? fg : fl;
+                for (int i = 0; i < k.scale; i++) px[c * k.scale + i] = (ol || fi) ? color : 0;
+                if ((ol || fi) && runStart < 0) runStart = c;
+                if (!(ol || fi) && runStart >= 0) {
+                    e->spans[s++] = (uint16_t)(runStart * k.scale);
+                    e->spans[s++] = (uint16_t)(c * k.scale);
+                    runStart = -1;
+                }
+            }
+            if (runStart >= 0) {
+                e->spans[s++] = (uint16_t)(runStart * k.scale);
+                e->spans[s++] = (uint16_t)w;
+            }
+        }
+        e->rowSpan[srcH] = (uint16_t)s;
+
+        _stats.bytesUsed += bytes;
+        _stats.entries++;
+        return e;
+    }
+
+    static void _blit(const BlitTarget& t, const Entry& e, int x, int y) {
+        for (int r = 0; r < e.h; r++) {
+            int dy0 = y + r * e.scale;
+            int dy1 = dy0 + e.scale;
+            if (dy1 <= 0) continue;
+            if (dy0 >= t.height) break;
+            if (dy0 < 0)        dy0 = 0;
+            if (dy1 > t.height) dy1 = t.height;
+
+            const uint16_t* src = e.pixels + r * e.w;
+            for (int s = e.rowSpan[r]; s < e.rowSpan[r + 1]; s += 2) {
+                int x0 = e.spans[s], x1 = e.spans[s + 1];
+                if (x + x0 < 0)        x0 = -x;
+                if (x + x1 > t.width)  x1 = t.width - x;
+                if (x0 >= x1) continue;
+                size_t n = (size_t)(x1 - x0) * 2;
+                for (int dy = dy0; dy < dy1; dy++)
+                    memcpy(t.buf + dy * t.width + x + x0, src + x0, n);
+            }
+        }
+    }
+};
@@ -0,0 +1,140 @@
+#pragma once
+// StatDynamics.h - Stat ids, tiers, and the once-per-tick stat update
+//
+// Every stat drifts at its tier's decay rate (config.h STAT_DECAY_*).  The
+// active behavior adds its per-second StatEffect rates into a sparse rate
+// vector during the frame; tick() then applies decay + rates and clamps all
+// stats in one pass over contiguous float arrays, which the compiler turns
+// into vector code.  advance() is the same update with no behavior rates, so
+// catching up hours of offline time costs one pass.
+
+#include <Arduino.h>
+#include "config.h"
+
+// ── Stat ids ──────────────────────────────────────────────────────────────
+
+// Index into GameContext::stats.  Names (STAT_NAMES) are the persistence
+// keys and what behavior tables used to reference stats by.
+enum class StatId : uint8_t {
+    // Rapidly changing (daily)
+    Fullness, Energy, Comfort, Playfulness, Focus,
+    // Medium changing (weekly)
+    Health, Fulfillment, Cleanliness, Curiosity, Independence, Sociability,
+    Routine, Intelligence, Resilience, Maturity, Grace, Affection,
+    // Slow changing (monthly)
+    Fitness, Appetite, Patience, Charisma, Craftiness, Serenity,
+    // Traits (near-static)
+    Courage, Loyalty, Mischievousness, Dignity,
+    Count
+};
+static const int STAT_COUNT = (int)StatId::Count;
+// Stat arrays are padded to whole 4-float vectors so the update loops have
+// no scalar tail; the padding lanes never change
+static const int STAT_LANES = (STAT_COUNT + 3) & ~3;
+
+static constexpr const char* STAT_NAMES[STAT_COUNT] = {
+    "fullness", "energy", "comfort", "playfulness", "focus",
+    "health", "fulfillment", "cleanliness", "curiosity", "independence", "sociability",
+    "routine", "intelligence", "resilience", "maturity", "grace", "affection",
+    "fitness", "appetite", "patience", "charisma", "craftiness", "serenity",
+    "courage", "loyalty", "mischievousness", "dignity",
+};
+
+static constexpr bool statNameEq(const char* a, const char* b) {
+    return *a == *b && (*a == '\0' || statNameEq(a + 1, b + 1));
+}
+
+// Name -> id; StatId::Count for an unknown name.  constexpr, so tables can
+// resolve names at compile time.
+static constexpr StatId statIdFromName(const char* name, int i = 0) {
+    return i >= STAT_COUNT ? StatId::Count
+         : statNameEq(name, STAT_NAMES[i]) ? (StatId)i
+         : statIdFromName(name, i + 1);
+}
+
+static constexpr const char* statName(StatId id) {
+    return (int)id < STAT_COUNT ? STAT_NAMES[(int)id] : "";
+}
+
+// ── Tiers ─────────────────────────────────────────────────────────────────
+
+enum class StatTier : uint8_t { Daily, Weekly, Monthly, Trait };
+
+static constexpr StatTier statTier(StatId id) {
+    return id < StatId::Health  ? StatTier::Daily
+         : id < StatId::Fitness ? StatTier::Weekly
+         : id < StatId::Courage ? StatTier::Monthly
+                                : StatTier::Trait;
+}
+
+// Decay in points per second (positive = falls over time)
+static inline float statDecayPerSec(StatId id) {
+    return (statTier(id) == StatTier::Daily   ? STAT_DECAY_DAILY
+          : statTier(id) == StatTier::Weekly  ? STAT_DECAY_WEEKLY
+          : statTier(id) == StatTier::Monthly ? STAT_DECAY_MONTHLY
+                                              : STAT_DECAY_TRAIT) / 86400.0f;
+}
+
+// Stat effect entry: stat + rate per second (or completion bonus)
+struct StatEffect {
+    StatId stat;
+    float  rate;
+};
+
+// ── Dynamics ──────────────────────────────────────────────────────────────
+
+class StatDynamics {
+public:
+    StatDynamics() {
+        for (int i = 0; i < STAT_LANES; i++) {
+            _decay[i] = i < STAT_COUNT ? statDecayPerSec((StatId)i) : 0.0f;
+            _rate[i]  = 0.0f;
+            _carry[i] = 0.0f;
+        }
+    }
+
+    // Add a behavior's per-second rates for the current tick
+    void addRates(const StatEffect* fx, int count) {
+        for (int i = 0; i < count; i++) _rate[(int)fx[i].stat] += fx[i].rate;
+    }
+
+    // Apply decay and this tick's rates over dt seconds, clamp to 0-100 and
+    // clear the rates.  stats holds STAT_LANES floats.  A frame's worth of
+    // weekly or monthly decay is below float resolution at typical values,
+    // so what each add loses to rounding is carried into the next tick.
+    // Written branch-free so it vectorizes.
+    void tick(float* __restrict stats, float dt) {
+        float* __restrict rate  = _rate;
+        float* __restrict carry = _carry;
+        const float* __restrict decay = _decay;
+        for (int i = 0; i < STAT_LANES; i++) {
+            float d = (rate[i] - decay[i]) * dt + carry[i];
+            float v = stats[i] + d;
+            float c = v < 0.0f ? 0.0f : v > 100.0f ? 100.0f : v;
+            // Rounding is under half an ulp of 100; anything larger is what
+            // the clamp cut off, which mustn't build up
+            float r = d - (c - stats[i]);
+            carry[i] = r < -1e-5f ? -1e-5f : r > 1e-5f ? 1e-5f : r;
+            stats[i] = c;
+            rate[i]  = 0.0f;
+        }
+    }
+
+    // Decay only, for time that passed with nothing running.  Decay is linear
+    // and clamped, so one step over the whole interval is exact.
+    void advance(float* __restrict stats, float seconds) const {
+        const float* __restrict decay = _decay;
+        for (int i = 0; i < STAT_LANES; i++) {
+            float v = stats[i] - decay[i] * seconds;
+            stats[i] = v < 0.0f ? 0.0f : v > 100.0f ? 100.0f : v;
+        }
+    }
+
+    float decay(StatId id) const           { return _decay[(int)id]; }
+    void  setDecay(StatId id, float perSec) { _decay[(int)id] = perSec; }
+
+private:
+    alignas(16) float _decay[STAT_LANES];
+    alignas(16) float _rate[STAT_LANES];
+    alignas(16) float _carry[STAT_LANES];   // rounding left over from tick()
+};
@@ -0,0 +1,125 @@
+#pragma once
+// TileDiff.h - Frame differencing by hashing 16x16 screen tiles
+//
+// Each show() hashes the tiles covered by the dirty region and compares them
+// against the hashes of the previous frame.  Changed tiles on the same tile
+// row are merged into horizontal spans, which become the push region.  Only a
+// hash per tile is kept, so this costs ~0.5 KB instead of a frame copy.
+//
+// A 32-bit hash can collide: a tile that changed to content hashing the same
+// as before would stay stale on the panel.  To bound that, every
+// TILE_DIFF_REFRESH_FRAMES frames the next tile row in turn is pushed
+// regardless of its hashes.
+
+#include <stdint.h>
+#include "config.h"
+#include "DirtyRegion.h"
+
+static const int TILE_SIZE = 16;
+static const int TILE_COLS = (DISPLAY_WIDTH  + TILE_SIZE - 1) / TILE_SIZE;
+static const int TILE_ROWS = (DISPLAY_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+
+struct TileDiffStats {
+    uint32_t hashed       = 0;  // tiles hashed last frame
+    uint32_t changed      = 0;  // tiles pushed last frame
+    uint64_t totalTiles   = 0;  // since resetCounters()
+    uint64_t totalSkipped = 0;
+
+    // Share of tiles not pushed last frame / since reset
+    float skippedPct() const {
+        return 100.0f * (TILE_COLS * TILE_ROWS - changed) / (TILE_COLS * TILE_ROWS);
+    }
+    float avgSkippedPct() const {
+        return totalTiles ? 100.0f * totalSkipped / totalTiles : 0.0f;
+    }
+};
+
+class TileDiff {
+public:
+    TileDiff() : _frame(0), _refreshRow(0) { invalidate(); }
+
+    // Forget previous hashes; the next diff reports every tile as changed
+    void invalidate() { _valid = false; }
+
+    const TileDiffStats& stats() const { return _stats; }
+    void resetCounters() { _stats.totalTiles = _stats.totalSkipped = 0; }
+
+    // buf: byte-swapped RGB565, DISPLAY_WIDTH x DISPLAY_HEIGHT.
+    // dirty: regions drawn this frame (tiles outside can't have changed).
+    // Replaces dirty with the changed tile spans.
+    void diff(const uint16_t* buf, DirtyRegion& dirty) {
+        bool candidate[TILE_ROWS][TILE_COLS] = {};
+        if (!_valid || dirty.full()) {
+            for (int r = 0; r < TILE_ROWS; r++)
+                for (int c = 0; c < TILE_COLS; c++) candidate[r][c] = true;
+        } else {
+            for (int i = 0; i < dirty.count(); i++) {
+                const DirtyRect& d = dirty.rect(i);
+                for (int r = d.y / TILE_SIZE; r <= (d.bottom() - 1) / TILE_SIZE; r++)
+                    for (int c = d.x / TILE_SIZE; c <= (d.right() - 1) / TILE_SIZE; c++)
+                        candidate[r][c] = true;
+            }
+        }
+
+        // Row pushed this frame whatever its hashes say, or -1
+        int refresh = -1;
+        if (TILE_DIFF_REFRESH_FRAMES > 0 && ++_frame % TILE_DIFF_REFRESH_FRAMES == 0) {
+            refresh     = _refreshRow;
+            _refreshRow = (_refreshRow + 1) % TILE_ROWS;
+            for (int c = 0; c < TILE_COLS; c++) candidate[refresh][c] = true;
+        }
+
+        _stats.hashed = _stats.changed = 0;
+        DirtyRegion out;
+        for (int r = 0; r < TILE_ROWS; r++) {
+            int spanStart = -1;
+            for (int c = 0; c <= TILE_COLS; c++) {
+                bool changed = false;
+                if (c < TILE_COLS && candidate[r][c]) {
+                    uint32_t h = _hashTile(buf, c, r);
+                    _stats.hashed++;
+                    changed = !_valid || r == refresh || h != _hash[r][c];
+                    _hash[r][c] = h;
+                }
+                if (changed) {
+                    _stats.changed++;
+                    if (spanStart < 0) spanStart = c;
+                } else if (spanStart >= 0) {
+                    out.add(spanStart * TILE_SIZE, r * TILE_SIZE,
+                            (c - spanStart) * TILE_SIZE, TILE_SIZE);
+                    spanStart = -1;
+                }
+            }
+        }
+        _valid = true;
+
+        _stats.totalTiles   += TILE_COLS * TILE_ROWS;
+        _stats.totalSkipped += TILE_COLS * TILE_ROWS - _stats.changed;
+        dirty = out;
+    }
+
+private:
+    uint32_t      _hash[TILE_ROWS][TILE_COLS];
+    bool          _valid;
+    uint32_t      _frame;
+    int           _refreshRow;   // next row to push regardless of hashes
+    TileDiffStats _stats;
+
+    // FNV-1a over 32-bit words (tile columns are always pixel-pair aligned)
+    static uint32_t _hashTile(const uint16_t* buf, int tc, int tr) {
+        int x0 = tc * TILE_SIZE, y0 = tr * TILE_SIZE;
+        int w  = min(TILE_SIZE, DISPLAY_WIDTH  - x0);
+        int h  = min(TILE_SIZE, DISPLAY_HEIGHT - y0);
+        uint32_t hash = 2166136261u;
+        for (int y = y0; y < y0 + h; y++) {
+            const uint16_t* p = buf + y * DISPLAY_WIDTH + x0;
+            int x = 0;
+            for (; x + 1 < w; x += 2) {
+                uint32_t word = (uint32_t)p[x] | ((uint32_t)p[x + 1] << 16);
+                hash = (hash ^ word) * 16777619u;
+            }
+            if (x < w) hash = (hash ^ p[x]) * 16777619u;
+        }
+        return hash;
+    }
+};
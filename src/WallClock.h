@@ -0,0 +1,25 @@
+#pragma once
+// WallClock.h - Unix time from the RTC, for timestamps that survive power-off
+
+#include <M5Unified.h>
+
+// Days since 1970-01-01 for a proleptic Gregorian date
+static inline int32_t daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    int32_t era = (y >= 0 ? y : y - 399) / 400;
+    int32_t yoe = y - era * 400;
+    int32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Seconds since 1970 by the RTC's reckoning; 0 when there is no RTC.  Only
+// differences matter, so an RTC that was never set (counting from its reset
+// date) works as well as one that was; a reading before 1970 counts as none.
+static inline uint32_t wallClockSec() {
+    if (!M5.Rtc.isEnabled()) return 0;
+    m5::rtc_datetime_t dt = M5.Rtc.getDateTime();
+    if (dt.date.year < 1970) return 0;
+    return (uint32_t)daysFromCivil(dt.date.year, dt.date.month, dt.date.date) * 86400u
+         + dt.time.hours * 3600u + dt.time.minutes * 60u + dt.time.seconds;
+}
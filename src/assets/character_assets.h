@@ -536,7 +536,7 @@ struct PoseEntry {
   bool head_first;
 };
 
-static const PoseEntry POSE_TABLE[] = {
+static constexpr PoseEntry POSE_TABLE[] = {
   {"sitting", "side", "neutral", &CHAR_BODY_SIDE_SITTING, &CHAR_HEAD_SIDE_NEUTRAL, &CHAR_EYES_SIDE_NEUTRAL, &CHAR_TAIL_NEUTRAL, false},
   {"sitting", "side", "angry", &CHAR_BODY_SIDE_SITTING, &CHAR_HEAD_SIDE_AIRPLANE, &CHAR_EYES_SIDE_ANGRY, &CHAR_TAIL_ANNOYED, false},
   {"sitting", "side", "happy", &CHAR_BODY_SIDE_SITTING, &CHAR_HEAD_SIDE_NEUTRAL, &CHAR_EYES_SIDE_HAPPY, &CHAR_TAIL_NEUTRAL, false},
@@ -577,17 +577,93 @@ static const PoseEntry POSE_TABLE[] = {
   {"costume_sitting", "side", "witch_annoyed", &CHAR_BODY_SIDE_WITCH, &CHAR_HEAD_SIDE_WITCH, &CHAR_EYES_SIDE_ANNOYED, &CHAR_TAIL_ANNOYED, false},
   {"costume_sitting", "side", "witch_happy", &CHAR_BODY_SIDE_WITCH, &CHAR_HEAD_SIDE_WITCH, &CHAR_EYES_SIDE_HAPPY, &CHAR_TAIL_NEUTRAL, false},
 };
-static const int POSE_TABLE_SIZE = 39;
-
-inline const PoseEntry* findPose(const char* name) {
-  char buf[64]; strncpy(buf, name, 63); buf[63]=0;
-  char* p1 = strtok(buf, "."); if(!p1) return nullptr;
-  char* p2 = strtok(nullptr, "."); if(!p2) return nullptr;
-  char* p3 = strtok(nullptr, "."); if(!p3) return nullptr;
-  for(int i=0; i<POSE_TABLE_SIZE; i++) {
-    const PoseEntry& e = POSE_TABLE[i];
-    if(strcmp(e.position,p1)==0 && strcmp(e.direction,p2)==0 && strcmp(e.emotion,p3)==0)
-      return &POSE_TABLE[i];
+static constexpr int POSE_TABLE_SIZE = sizeof(POSE_TABLE) / sizeof(POSE_TABLE[0]);
+
+// ============================================================
+// Pose lookup
+// ============================================================
+// A PoseId is a POSE_TABLE index, so switching pose by id is one array
+// access.  poseId() resolves a name at compile time (and fails to compile
+// for a name that isn't in the table); findPoseId() resolves one at run
+// time by FNV-1a hash of the full "position.direction.emotion" name and a
+// binary search over the table's hashes, sorted at compile time.
+
+enum class PoseId : uint8_t { None = 0xFF };
+
+constexpr uint32_t poseHashStep(uint32_t h, const char* s) {
+  for (; *s; s++) h = (h ^ (uint8_t)*s) * 16777619u;
+  return h;
+}
+
+constexpr uint32_t poseHash(const char* name) { return poseHashStep(2166136261u, name); }
+
+constexpr uint32_t poseHash(const PoseEntry& e) {
+  return poseHashStep(poseHashStep(poseHashStep(poseHashStep(poseHashStep(
+      2166136261u, e.position), "."), e.direction), "."), e.emotion);
+}
+
+// name == "<position>.<direction>.<emotion>" of e
+constexpr bool poseNameEq(const char* name, const PoseEntry& e) {
+  const char* parts[3] = { e.position, e.direction, e.emotion };
+  for (int i = 0; i < 3; i++) {
+    for (const char* p = parts[i]; *p; p++, name++)
+      if (*name != *p) return false;
+    if (*name++ != (i < 2 ? '.' : '\0')) return false;
+  }
+  return true;
+}
+
+struct PoseIndex {
+  uint32_t hash[POSE_TABLE_SIZE];   // ascending
+  uint8_t  id[POSE_TABLE_SIZE];
+
+  constexpr PoseIndex() : hash(), id() {
+    for (int i = 0; i < POSE_TABLE_SIZE; i++) {
+      uint32_t h = poseHash(POSE_TABLE[i]);
+      int j = i;
+      for (; j > 0 && hash[j - 1] > h; j--) { hash[j] = hash[j - 1]; id[j] = id[j - 1]; }
+      hash[j] = h;
+      id[j]   = (uint8_t)i;
+    }
+  }
+
+  constexpr bool distinct() const {
+    for (int i = 1; i < POSE_TABLE_SIZE; i++)
+      if (hash[i] == hash[i - 1]) return false;
+    return true;
+  }
+};
+static constexpr PoseIndex POSE_INDEX{};
+static_assert(POSE_INDEX.distinct(), "two pose names share a hash: change the seed");
+static_assert(POSE_TABLE_SIZE < (int)PoseId::None, "PoseId is a uint8_t index");
+
+inline PoseId findPoseId(const char* name) {
+  if (!name) return PoseId::None;
+  uint32_t h = poseHash(name);
+  int lo = 0, hi = POSE_TABLE_SIZE;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (POSE_INDEX.hash[mid] < h) lo = mid + 1;
+    else                          hi = mid;
   }
-  return nullptr;
-}
\ No newline at end of file
+  if (lo == POSE_TABLE_SIZE || POSE_INDEX.hash[lo] != h) return PoseId::None;
+  int id = POSE_INDEX.id[lo];
+  return poseNameEq(name, POSE_TABLE[id]) ? (PoseId)id : PoseId::None;
+}
+
+inline const PoseEntry* poseEntry(PoseId id) {
+  return (int)id < POSE_TABLE_SIZE ? &POSE_TABLE[(int)id] : nullptr;
+}
+
+inline const PoseEntry* findPose(const char* name) { return poseEntry(findPoseId(name)); }
+
+// Not constexpr: poseId() reaching this in a constant expression is a
+// compile error naming the problem
+inline PoseId pose_name_not_in_POSE_TABLE() { return PoseId::None; }
+
+// Compile-time name -> id, for behaviors' pose constants
+constexpr PoseId poseId(const char* name) {
+  for (int i = 0; i < POSE_TABLE_SIZE; i++)
+    if (poseNameEq(name, POSE_TABLE[i])) return (PoseId)i;
+  return pose_name_not_in_POSE_TABLE();
+}
@@ -18,12 +18,91 @@ static const int PLAY_Y      = STATUS_BAR_HEIGHT;
 // Sprite render scale: original 128x64 sprites drawn at 2x
 static const int SPRITE_SCALE = 2;
 
+// Byte budget for pre-expanded sprite tiles (0 = cache off)
+static const uint32_t SPRITE_CACHE_BYTES = 48 * 1024;
+
+// Particle pool for weather and behavior effects (see Particles.h): live
+// particles at most, and how many may spawn in one frame
+static const int PARTICLE_MAX          = 512;
+static const int PARTICLE_FRAME_BUDGET = 32;
+
+// Partial display push: dirty rects are merged once there are more than
+// DIRTY_MAX_RECTS of them, and the whole frame is pushed once they cover
+// DIRTY_FULL_PUSH_PCT of the screen. DIRTY_MERGE_SLACK is the wasted area
+// (pixels) tolerated when folding a new rect into an existing one.
+static const int DIRTY_MAX_RECTS      = 12;
+static const int DIRTY_FULL_PUSH_PCT  = 70;
+static const int DIRTY_MERGE_SLACK    = 256;
+
+// Hash 16x16 tiles every frame and push only the ones that changed, instead
+// of the per-scene frame copy (see Scene::diffFrames)
+static const bool USE_TILE_DIFF       = false;
+
+// With tile diff, every this many frames one tile row is pushed whether its
+// hash changed or not, so a tile left stale by a hash collision is repaired
+// within TILE_ROWS times as many frames (0 = never)
+static const int TILE_DIFF_REFRESH_FRAMES = 8;
+
+// Send frames by DMA from a second buffer while the next frame is simulated
+// and drawn; falls back to blocking pushes if the buffer can't be allocated
+static const bool USE_ASYNC_PUSH      = true;
+
+// Record draw calls and run them in one culled, batched pass in show()
+static const bool USE_RETAINED_DRAW   = false;
+
 // ============================================================================
 // Game loop
 // ============================================================================
 static const int   FPS            = 12;
 static const int   FRAME_TIME_MS  = 1000 / FPS;
 
+// Print average update/draw/push/wait times (us) over Serial once a second
+static const bool  LOG_FRAME_TIMING = false;
+
+// Zone profiler (see Profiler.h): rolling window in frames, and whether to
+// stream binary frame packets over Serial for tools/profdecode.py
+static const bool  PROFILER_ENABLED = true;
+static const int   PROFILER_WINDOW  = 32;
+static const bool  PROFILER_STREAM  = false;
+
+// Run simulation and rasterization as separate tasks on the two cores,
+// handing frames over as recorded draw lists (see FramePipeline.h)
+static const bool  USE_RENDER_PIPELINE  = false;
+static const int   PIPELINE_SIM_CORE    = 1;   // the Arduino loop core
+static const int   PIPELINE_RASTER_CORE = 0;
+static const int   PIPELINE_SLOTS       = 2;   // draw lists in flight
+static const int   DRAW_LIST_MAX_CMDS   = 384;
+static const int   DRAW_LIST_TEXT_BYTES = 1024;
+
+// ============================================================================
+// Pet stats
+// ============================================================================
+// Background decay in points per day for each stat tier (see StatDynamics.h),
+// on top of whatever the current behavior does
+static const float STAT_DECAY_DAILY   = 40.0f;
+static const float STAT_DECAY_WEEKLY  = 40.0f / 7;
+static const float STAT_DECAY_MONTHLY = 40.0f / 30;
+static const float STAT_DECAY_TRAIT   = 0.0f;
+
+// Longest power-off gap caught up on boot (see OfflineProgress.h)
+static const float OFFLINE_MAX_DAYS   = 30.0f;
+
+// Saving (see Persistence.h): settings, scores and inventory are written once
+// unchanged for PERSIST_QUIET_S; stats once one has moved by
+// PERSIST_STAT_EPSILON, at most PERSIST_MAX_DELAY_S later
+static const float PERSIST_QUIET_S      = 3.0f;
+static const float PERSIST_MAX_DELAY_S  = 60.0f;
+static const float PERSIST_STAT_EPSILON = 0.5f;
+static const int   JOURNAL_SLOTS        = 16;   // records between snapshots
+
+// Behaviors are constructed in fixed slots (see BehaviorPool.h)
+static const int   BEHAVIOR_POOL_SLOTS  = 3;
+
+// Picking the next autonomous behavior (see UtilityScheduler.h)
+static const int   UTILITY_MEMORY         = 4;      // recent picks remembered
+static const float UTILITY_REPEAT_PENALTY = 0.15f;  // per recent pick
+static const float UTILITY_TIE_BAND       = 0.05f;  // pick randomly within this of the best
+
 // ============================================================================
 // Camera / panning
 // ============================================================================
@@ -5,6 +5,7 @@
 #include "Entity.h"
 #include "Renderer.h"
 #include "GameContext.h"
+#include "Particles.h"
 #include "assets/character_assets.h"
 
 class BaseBehavior;
@@ -19,34 +20,40 @@ struct PartAnim {
 
 class CharacterEntity : public Entity {
 public:
-    GameContext* context;
+    GameContext*    context;
+    ParticleSystem* particles = nullptr;   // for behavior effects; none if null
 
     CharacterEntity(float x, float y, const char* pose = "sitting.forward.neutral",
                     GameContext* ctx = nullptr)
         : Entity(x, y), context(ctx),
-          _poseName(pose), _poseEntry(nullptr),
-          _currentBehavior(nullptr)
-    {
-        _poseEntry = findPose(pose);
-    }
+          _pose(findPoseId(pose)), _poseEntry(poseEntry(_pose)),
+          _currentBehavior(nullptr), _retiredBehavior(nullptr)
+    {}
 
-    ~CharacterEntity() {
-        delete _currentBehavior;
-    }
+    ~CharacterEntity();
 
     // ── Pose ─────────────────────────────────────────────────────────────
-    bool setPose(const char* name) {
-        const PoseEntry* p = findPose(name);
+    // Behaviors resolve their poses with poseId() at compile time; the name
+    // overload looks the name up first
+    bool setPose(PoseId id) {
+        const PoseEntry* p = poseEntry(id);
         if (!p) return false;
-        _poseName  = name;
+        _pose      = id;
         _poseEntry = p;
         return true;
     }
+    bool setPose(const char* name) { return setPose(findPoseId(name)); }
 
-    const char* poseName() const { return _poseName; }
+    PoseId pose() const { return _pose; }
 
     // ── Behavior management ───────────────────────────────────────────────
+    // Behaviors live in behaviorPool(); make one with makeBehavior<B>().
+    // Replacing the current behavior without trigger() (a behavior chaining
+    // to the next from inside its own stop()) releases the old one at the
+    // end of the frame's behavior update, once it is off the stack.
     void setCurrentBehavior(BaseBehavior* b) {
+        if (b == _currentBehavior) return;
+        _retire(_currentBehavior);
         _currentBehavior = b;
     }
 
@@ -55,6 +62,8 @@ public:
     // Interrupt any current behavior and start the given one
     void trigger(BaseBehavior* newBehavior);
 
+    template <class B> B* makeBehavior();
+
     // Called by BaseBehavior::_chainTo when it needs a fresh idle
     BaseBehavior* makeIdleBehavior();
 
@@ -75,9 +84,13 @@ public:
         _updateBehavior(dt);
     }
 
-    // Draw the character at its world position minus camera_offset
+    // Draw the character at its world position minus camera_offset.  The
+    // four parts are drawn one by one: each is a single SpriteCache span copy
+    // with fill and outline already composited, and eyes and tail animate on
+    // their own clocks, so baking whole poses would not draw any faster.
     void draw(Renderer& r, bool mirror = false, int cameraOffset = 0, int scale = SPRITE_SCALE) {
         if (!visible || !_poseEntry) return;
+        ProfileScope prof(ProfZone::CharacterDraw);
 
         const PoseEntry& p = *_poseEntry;
         int px = (int)x - cameraOffset;
@@ -140,9 +153,10 @@ public:
     }
 
 private:
-    const char*      _poseName;
+    PoseId           _pose;
     const PoseEntry* _poseEntry;
     BaseBehavior*    _currentBehavior;
+    BaseBehavior*    _retiredBehavior;   // replaced this frame, released after update
 
     PartAnim _body, _head, _eyes, _tail;
 
@@ -161,30 +175,49 @@ private:
     }
 
     // Bodies defined after IdleBehavior.h is included (below class)
+    void _retire(BaseBehavior* b);
     void _updateBehavior(float dt);
     void _drawBehavior(Renderer& r, int px, int py, bool mirror);
 };
 
-// ── Lazy-include of behaviors needed for makeIdleBehavior ────────────────
-#include "behaviors/IdleBehavior.h"
+// ── Lazy-include of every behavior and the pool they live in ─────────────
+#include "behaviors/BehaviorPool.h"
+
+inline CharacterEntity::~CharacterEntity() {
+    behaviorPool().release(_retiredBehavior);
+    behaviorPool().release(_currentBehavior);
+}
+
+template <class B>
+inline B* CharacterEntity::makeBehavior() {
+    return behaviorPool().acquire<B>(this);
+}
 
 inline BaseBehavior* CharacterEntity::makeIdleBehavior() {
-    return new IdleBehavior(this);
+    return makeBehavior<IdleBehavior>();
 }
 
 inline void CharacterEntity::trigger(BaseBehavior* newBehavior) {
     if (_currentBehavior && _currentBehavior->active())
         _currentBehavior->stop(false);
-    delete _currentBehavior;
+    behaviorPool().release(_currentBehavior);
     _currentBehavior = newBehavior;
     if (_currentBehavior) _currentBehavior->start();
 }
 
+inline void CharacterEntity::_retire(BaseBehavior* b) {
+    behaviorPool().release(_retiredBehavior);
+    _retiredBehavior = b;
+}
+
 inline void CharacterEntity::_updateBehavior(float dt) {
     if (_currentBehavior && context) {
-        _currentBehavior->applyStatEffects(context, dt);
+        ProfileScope prof(ProfZone::BehaviorUpdate);
+        _currentBehavior->applyStatEffects(context);
         _currentBehavior->update(dt);
     }
+    behaviorPool().release(_retiredBehavior);
+    _retiredBehavior = nullptr;
 }
 
 inline void CharacterEntity::_drawBehavior(Renderer& r, int px, int py, bool mirror) {
@@ -5,21 +5,19 @@ class AffectionBehavior : public BaseBehavior {
 public:
     AffectionBehavior(CharacterEntity* c) : BaseBehavior(c), _duration(2.0f) {}
     const char* name() const override { return "affection"; }
-    int   priority() const override { return 5; }
 
     // variant: "kiss"=bigger stat bonus longer; "pets"=shorter smaller bonus
     void start(const char* variant=nullptr, CompleteCb cb=nullptr, void* ud=nullptr) {
         if(_active)return;
         BaseBehavior::start(cb,ud);
-        _phase="reacting";
         if(variant && strcmp(variant,"kiss")==0){
             _duration=2.5f;
-            if(_character) _character->setPose("sitting.side.happy");
-            if(_character&&_character->context) _character->context->addStat("affection",10.0f);
+            if(_character) _character->setPose(POSE_SITTING_SIDE_HAPPY);
+            if(_character&&_character->context) _character->context->addStat(StatId::Affection,10.0f);
         } else {
             _duration=2.0f;
-            if(_character) _character->setPose("sitting.forward.happy");
-            if(_character&&_character->context) _character->context->addStat("affection",5.0f);
+            if(_character) _character->setPose(POSE_SITTING_FORWARD_HAPPY);
+            if(_character&&_character->context) _character->context->addStat(StatId::Affection,5.0f);
         }
     }
     void start(CompleteCb cb=nullptr,void* ud=nullptr) override { start(nullptr,cb,ud); }
@@ -3,48 +3,95 @@
 
 #include <Arduino.h>
 #include "GameContext.h"
+#include "assets/character_assets.h"
 
 class Renderer;
-class CharacterEntity;
 
-// Stat effect entry: stat name + rate per second (or completion bonus)
-struct StatEffect {
-    const char* stat;
-    float       rate;
+// ── Autonomous behaviors ──────────────────────────────────────────────────
+// A behavior the pet starts on its own declares
+//     static constexpr TriggerSpec TRIGGER = { n, { conditions } };
+//     static constexpr UtilitySpec UTILITY = { base, cooldown, n, { terms } };
+// and is listed in BEHAVIOR_REGISTRY (IdleBehavior.h).  It can be picked
+// while all its trigger conditions hold; UtilityScheduler.h picks among
+// those by utility score.
+struct TriggerCond {
+    StatId stat;
+    float  threshold;
+    bool   below;          // stat < threshold, else stat > threshold
 };
+static constexpr TriggerCond statBelow(StatId s, float t) { return { s, t, true }; }
+static constexpr TriggerCond statAbove(StatId s, float t) { return { s, t, false }; }
+
+struct TriggerSpec {
+    int         condCount;   // 0 = always eligible
+    TriggerCond cond[2];
+
+    bool eligible(const float* stats) const {
+        for (int i = 0; i < condCount; i++) {
+            float v = stats[(int)cond[i].stat];
+            if (cond[i].below ? !(v < cond[i].threshold) : !(v > cond[i].threshold)) return false;
+        }
+        return true;
+    }
+};
+
+// Response curves over a stat's 0-100 range, both quadratic: Need rises
+// from 0 to 1 as the stat falls to 0, Surplus as it rises to 100
+enum class UtilityCurve : uint8_t { Need, Surplus };
+struct UtilityTerm {
+    StatId       stat;
+    UtilityCurve curve;
+    float        weight;
+};
+static constexpr UtilityTerm statNeed(StatId s, float w)    { return { s, UtilityCurve::Need, w }; }
+static constexpr UtilityTerm statSurplus(StatId s, float w) { return { s, UtilityCurve::Surplus, w }; }
+
+struct UtilitySpec {
+    float       base;
+    float       cooldownS;   // s after being picked before it can be again
+    int         termCount;
+    UtilityTerm term[3];     // base + sum of weight * curve(stat)
+};
+
+// Poses the behaviors switch between, resolved to ids at compile time
+static constexpr PoseId POSE_SITTING_SIDE_NEUTRAL      = poseId("sitting.side.neutral");
+static constexpr PoseId POSE_SITTING_SIDE_HAPPY        = poseId("sitting.side.happy");
+static constexpr PoseId POSE_SITTING_SIDE_ALOOF        = poseId("sitting.side.aloof");
+static constexpr PoseId POSE_SITTING_SIDE_LOOKING_DOWN = poseId("sitting.side.looking_down");
+static constexpr PoseId POSE_SITTING_FORWARD_NEUTRAL   = poseId("sitting.forward.neutral");
+static constexpr PoseId POSE_SITTING_FORWARD_HAPPY     = poseId("sitting.forward.happy");
+static constexpr PoseId POSE_SITTING_FORWARD_ALOOF     = poseId("sitting.forward.aloof");
+static constexpr PoseId POSE_STANDING_SIDE_NEUTRAL     = poseId("standing.side.neutral");
+static constexpr PoseId POSE_STANDING_SIDE_HAPPY       = poseId("standing.side.happy");
+static constexpr PoseId POSE_LEANING_FORWARD_SIDE_NEUTRAL = poseId("leaning_forward.side.neutral");
+static constexpr PoseId POSE_LEANING_FORWARD_SIDE_EATING  = poseId("leaning_forward.side.eating");
+static constexpr PoseId POSE_SLEEPING_SIDE_SPLOOT      = poseId("sleeping.side.sploot");
+static constexpr PoseId POSE_SLEEPING_SIDE_MODEST      = poseId("sleeping.side.modest");
+static constexpr PoseId POSE_SLEEPING_SIDE_CROSSED     = poseId("sleeping.side.crossed");
+
+class CharacterEntity;
 
 class BaseBehavior {
 public:
     explicit BaseBehavior(CharacterEntity* character)
         : _character(character), _active(false),
-          _phase(nullptr), _phaseTimer(0.0f), _progress(0.0f),
-          _poseBeforeName(nullptr), _onComplete(nullptr) {}
+          _phase(0), _phaseTimer(0.0f), _progress(0.0f),
+          _poseBefore(PoseId::None), _onComplete(nullptr) {}
 
     virtual ~BaseBehavior() {}
 
     // ── Overridable class-level properties ────────────────────────────────
     virtual const char*    name()           const = 0;
-    virtual const char*    triggerStat()    const { return nullptr; }
-    virtual float          triggerThreshold() const { return 50.0f; }
-    virtual bool           triggerBelow()   const { return true; }
-    virtual int            priority()       const { return 50; }
 
     // Stat effects during behavior (override to return your array)
     virtual const StatEffect* statEffects(int* count) const { *count=0; return nullptr; }
     // Completion bonuses
     virtual const StatEffect* completionBonus(int* count) const { *count=0; return nullptr; }
 
-    // ── Class-level trigger check ─────────────────────────────────────────
-    virtual bool canTrigger(GameContext* ctx) const {
-        if (!ctx || !triggerStat()) return false;
-        float val = ctx->getStat(triggerStat());
-        return triggerBelow() ? (val < triggerThreshold()) : (val > triggerThreshold());
-    }
-
     // ── Accessors ─────────────────────────────────────────────────────────
     bool        active()   const { return _active; }
     float       progress() const { return _progress; }
-    const char* phase()    const { return _phase; }
+    uint8_t     phase()    const { return _phase; }   // PhasedBehavior's phase enum
 
     // ── Lifecycle ─────────────────────────────────────────────────────────
     using CompleteCb = void(*)(bool completed, float progress, void* userData);
@@ -56,18 +103,18 @@ public:
         _progress     = 0.0f;
         _onComplete   = cb;
         _userData     = userData;
-        _poseBeforeName = _getCurrentPoseName();
+        _poseBefore   = _getCurrentPose();
     }
 
     virtual void stop(bool completed = true) {
         if (!_active) return;
         _active    = false;
-        _phase     = nullptr;
+        _phase     = 0;
         _phaseTimer= 0.0f;
 
-        if (completed && _poseBeforeName)
-            _character->setPose(_poseBeforeName);
-        _poseBeforeName = nullptr;
+        if (completed && _poseBefore != PoseId::None)
+            _character->setPose(_poseBefore);
+        _poseBefore = PoseId::None;
 
         CompleteCb cb = _onComplete;
         void*      ud = _userData;
@@ -95,21 +142,20 @@ public:
     // Return the next behavior to chain to (nullptr = idle)
     virtual BaseBehavior* nextBehavior(GameContext* ctx) { return nullptr; }
 
-    // Apply per-frame stat effects
-    void applyStatEffects(GameContext* ctx, float dt) {
+    // Add this frame's stat rates; GameContext::tickStats applies them
+    void applyStatEffects(GameContext* ctx) {
         if (!ctx) return;
         int count; const StatEffect* effects = statEffects(&count);
-        for (int i = 0; i < count; i++)
-            ctx->addStat(effects[i].stat, effects[i].rate * dt);
+        ctx->dynamics.addRates(effects, count);
     }
 
 protected:
     CharacterEntity* _character;
     bool             _active;
-    const char*      _phase;
+    uint8_t          _phase;
     float            _phaseTimer;
     float            _progress;
-    const char*      _poseBeforeName;
+    PoseId           _poseBefore;
     CompleteCb       _onComplete  = nullptr;
     void*            _userData    = nullptr;
 
@@ -123,13 +169,132 @@ protected:
     // Platform-specific: get GameContext from character
     GameContext* _getContext();
 
-    // Get current pose name from character
-    const char* _getCurrentPoseName();
+    // Get current pose from character
+    PoseId _getCurrentPose();
+    void   _setPose(PoseId pose);
 
     // Chain to next behavior (install it on the character)
     void _chainTo(BaseBehavior* next);
 };
 
+// ── Phase machines ────────────────────────────────────────────────────────
+// A behavior that runs through a fixed timeline derives from
+// PhasedBehavior<P>, where P is an enum of its phases ending in Done, and
+// declares
+//     static constexpr PhaseStep<P> PHASES[] = { ... };   // one per phase, in enum order
+// The default start() enters the first phase and update() advances the
+// timer; the driver sets each phase's pose on entry and moves on to next
+// when the phase's seconds are up.
+template <class P>
+struct PhaseStep {
+    P      phase;      // must equal its index in PHASES
+    float  seconds;    // < 0: the behavior leaves the phase itself
+    PoseId pose;       // set on entry; PoseId::None keeps the current pose
+    P      next;       // P::Done stops the behavior, completed
+    bool   progress;   // _progress follows this phase's timer
+};
+
+template <class P, size_t N>
+constexpr bool phaseTableValid(const PhaseStep<P> (&t)[N]) {
+    if (N != (size_t)P::Done) return false;
+    for (size_t i = 0; i < N; i++)
+        if ((size_t)t[i].phase != i || (size_t)t[i].next > N || (t[i].progress && !(t[i].seconds > 0.0f)))
+            return false;
+    return true;
+}
+
+// Seconds from the first phase to Done, following next; timed phases only
+template <class P, size_t N>
+constexpr float phaseTableSeconds(const PhaseStep<P> (&t)[N]) {
+    float  s = 0.0f;
+    size_t p = 0;
+    for (size_t i = 0; i < N && p < N; i++, p = (size_t)t[p].next) s += t[p].seconds;
+    return s;
+}
+
+template <class P>
+class PhasedBehavior : public BaseBehavior {
+public:
+    using Step = PhaseStep<P>;
+
+    PhasedBehavior(CharacterEntity* character, const Step* steps)
+        : BaseBehavior(character), _steps(steps) {}
+
+    P phaseId() const { return (P)_phase; }
+
+    void start(CompleteCb cb = nullptr, void* userData = nullptr) override {
+        if (_active) return;
+        BaseBehavior::start(cb, userData);
+        _enterPhase((P)0);
+    }
+
+    void update(float dt) override {
+        if (!_active) return;
+        _tickPhases(dt);
+    }
+
+protected:
+    const Step* _steps;
+
+    bool _inPhase(P p) const { return _phase == (uint8_t)p; }
+
+    void _enterPhase(P p) {
+        _phase      = (uint8_t)p;
+        _phaseTimer = 0.0f;
+        if (_steps[_phase].pose != PoseId::None) _setPose(_steps[_phase].pose);
+    }
+
+    // Advance the phase timer by dt; true if that entered a new phase.  A
+    // phase leading to Done stops the behavior instead.
+    bool _tickPhases(float dt) {
+        const Step& s = _steps[_phase];
+        _phaseTimer += dt;
+        if (s.progress) _progress = min(1.0f, _phaseTimer / s.seconds);
+        if (s.seconds < 0.0f || _phaseTimer < s.seconds) return false;
+        if (s.next == P::Done) { stop(true); return false; }
+        _enterPhase(s.next);
+        return true;
+    }
+};
+
+// One run of a phased behavior from start to completion as the game plays
+// it, for offline catch-up.  Each phase lasts the frames its timer takes to
+// reach the phase's seconds at FPS, and the completion bonus counts only if
+// a phase tracks progress: it is scaled by progress, which otherwise stays 0.
+struct BehaviorSpan {
+    float             seconds;
+    const StatEffect* fx;
+    int               fxCount;
+    const StatEffect* bonus;
+    int               bonusCount;
+};
+
+// Frames a timer stepped by 1/FPS from 0 takes to reach seconds
+static inline int timerFrames(float seconds) {
+    const float dt = 1.0f / FPS;
+    int n = 0;
+    for (float t = 0.0f; t < seconds; t += dt) n++;
+    return n;
+}
+
+template <class B>
+static BehaviorSpan behaviorSpan() {
+    const int n = (int)B::Phase::Done;
+    int  frames   = 0;
+    bool progress = false;
+    for (int i = 0, p = 0; i < n && p < n; i++, p = (int)B::PHASES[p].next) {
+        frames   += timerFrames(B::PHASES[p].seconds);
+        progress |= B::PHASES[p].progress;
+    }
+    B b(nullptr);
+    BehaviorSpan s;
+    s.seconds = (float)frames / FPS;
+    s.fx      = b.statEffects(&s.fxCount);
+    s.bonus   = b.completionBonus(&s.bonusCount);
+    if (!progress) s.bonusCount = 0;
+    return s;
+}
+
 // Forward-declare helpers implemented in Character.cpp
 #include "entities/CharacterEntity.h"
 
@@ -137,8 +302,12 @@ inline GameContext* BaseBehavior::_getContext() {
     return _character ? _character->context : nullptr;
 }
 
-inline const char* BaseBehavior::_getCurrentPoseName() {
-    return _character ? _character->poseName() : nullptr;
+inline PoseId BaseBehavior::_getCurrentPose() {
+    return _character ? _character->pose() : PoseId::None;
+}
+
+inline void BaseBehavior::_setPose(PoseId pose) {
+    if (_character) _character->setPose(pose);
 }
 
 inline void BaseBehavior::_chainTo(BaseBehavior* next) {
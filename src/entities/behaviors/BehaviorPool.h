@@ -0,0 +1,102 @@
+#pragma once
+// BehaviorPool.h - Fixed slots every behavior is constructed in
+//
+// The pet changes behavior every few seconds.  Instead of a new/delete per
+// change, behaviors are placement-constructed in BEHAVIOR_POOL_SLOTS slots,
+// each sized at compile time for the largest behavior, and release() runs
+// the destructor and frees the slot.  Behaviors chain one step deep: a
+// finishing behavior's stop() makes its successor, which only starts, and
+// the one replaced is released at the end of the character's update.  So
+// the current scene's character holds two at most, the other cached scene's
+// character holds just its current one, and while a new scene loads each of
+// the three scenes' characters holds one: three slots are in use at most.
+// Should the slots ever run out, acquire() falls back to the heap and counts
+// it in stats().overflows.
+//
+// Included at the end of CharacterEntity.h, after every behavior.
+
+#include <new>
+#include "config.h"
+#include "IdleBehavior.h"
+#include "AffectionBehavior.h"
+#include "AttentionBehavior.h"
+#include "BeingGroomedBehavior.h"
+#include "ChatteringBehavior.h"
+#include "EatingBehavior.h"
+#include "SnackingBehavior.h"
+
+template <class... B>
+constexpr size_t behaviorMaxSize() {
+    size_t m = 0;
+    for (size_t s : { sizeof(B)... }) m = s > m ? s : m;
+    return m;
+}
+
+template <class... B>
+constexpr size_t behaviorMaxAlign() {
+    size_t m = 0;
+    for (size_t a : { alignof(B)... }) m = a > m ? a : m;
+    return m;
+}
+
+struct BehaviorPoolStats {
+    uint32_t acquired  = 0;
+    uint32_t inUse     = 0;
+    uint32_t peak      = 0;
+    uint32_t overflows = 0;   // acquires that fell back to the heap
+};
+
+class BehaviorPool {
+public:
+#define BEHAVIOR_TYPES IdleBehavior, SleepingBehavior, NappingBehavior, PlayingBehavior, \
+        ZoomiesBehavior, VocalizingBehavior, InvestigatingBehavior, ObservingBehavior, \
+        StretchingBehavior, SelfGroomingBehavior, LoungeingBehavior, KneadingBehavior, \
+        AffectionBehavior, AttentionBehavior, BeingGroomedBehavior, ChatteringBehavior, \
+        EatingBehavior, SnackingBehavior
+    static constexpr size_t SLOT_SIZE  = behaviorMaxSize<BEHAVIOR_TYPES>();
+    static constexpr size_t SLOT_ALIGN = behaviorMaxAlign<BEHAVIOR_TYPES>();
+#undef BEHAVIOR_TYPES
+
+    BehaviorPool() : _used(0) {}
+
+    // Construct a B(args...) in a free slot
+    template <class B, class... A>
+    B* acquire(A... args) {
+        static_assert(sizeof(B) <= SLOT_SIZE && alignof(B) <= SLOT_ALIGN,
+                      "behavior larger than a pool slot: add it to BEHAVIOR_TYPES");
+        _stats.acquired++;
+        int i = 0;
+        while (i < BEHAVIOR_POOL_SLOTS && (_used >> i & 1)) i++;
+        if (i == BEHAVIOR_POOL_SLOTS) {
+            _stats.overflows++;
+            return new B(args...);
+        }
+        _used |= 1u << i;
+        if (++_stats.inUse > _stats.peak) _stats.peak = _stats.inUse;
+        return new (_slots[i].bytes) B(args...);
+    }
+
+    // Destroy b and free its slot; nullptr is ignored
+    void release(BaseBehavior* b) {
+        if (!b) return;
+        uintptr_t off = (uintptr_t)b - (uintptr_t)_slots;
+        if (off >= sizeof(_slots)) { delete b; return; }
+        b->~BaseBehavior();
+        _used &= ~(1u << (off / sizeof(Slot)));
+        _stats.inUse--;
+    }
+
+    const BehaviorPoolStats& stats() const { return _stats; }
+
+private:
+    struct alignas(SLOT_ALIGN) Slot { unsigned char bytes[SLOT_SIZE]; };
+    Slot              _slots[BEHAVIOR_POOL_SLOTS];
+    uint32_t          _used;   // bit per slot
+    BehaviorPoolStats _stats;
+};
+static_assert(BEHAVIOR_POOL_SLOTS <= 32, "BehaviorPool tracks slots in a uint32_t");
+
+static inline BehaviorPool& behaviorPool() {
+    static BehaviorPool p;
+    return p;
+}
@@ -3,27 +3,36 @@
 #include "Renderer.h"
 #include "assets/items_assets.h"
 
-class EatingBehavior : public BaseBehavior {
+enum class EatingPhase : uint8_t { Lowering, PreEating, Eating, PostEating, Done };
+
+class EatingBehavior : public PhasedBehavior<EatingPhase> {
 public:
+    using Phase = EatingPhase;
     EatingBehavior(CharacterEntity* c)
-        : BaseBehavior(c), _bowlSprite(nullptr), _bowlFrame(0.0f),
+        : PhasedBehavior(c, PHASES), _bowlSprite(nullptr), _bowlFrame(0.0f),
           _bowlYProg(0.0f), _mealType(nullptr) {}
 
     const char* name() const override { return "eating"; }
-    int   priority() const override { return 10; }
+
+    // Eating lasts until the bowl animation has played through
+    static constexpr Step PHASES[] = {
+        { Phase::Lowering,    0.5f, POSE_STANDING_SIDE_HAPPY,          Phase::PreEating,  false },
+        { Phase::PreEating,   1.5f, POSE_LEANING_FORWARD_SIDE_NEUTRAL, Phase::Eating,     false },
+        { Phase::Eating,     -1.0f, POSE_LEANING_FORWARD_SIDE_EATING,  Phase::PostEating, false },
+        { Phase::PostEating,  1.5f, POSE_LEANING_FORWARD_SIDE_NEUTRAL, Phase::Done,       false },
+    };
+    static_assert(phaseTableValid(PHASES), "PHASES out of order");
 
     struct MealStat { const char* stat; float delta; };
 
     void start(const Sprite* bowl, const char* mealType,
                CompleteCb cb=nullptr, void* ud=nullptr) {
         if(_active)return;
-        BaseBehavior::start(cb,ud);
-        _phase="lowering";
+        PhasedBehavior::start(cb,ud);
         _bowlSprite=bowl;
         _bowlFrame=0.0f;
         _bowlYProg=0.0f;
         _mealType=mealType;
-        if(_character) _character->setPose("standing.side.happy");
     }
     void start(CompleteCb cb=nullptr,void* ud=nullptr) override {
         start(nullptr,nullptr,cb,ud);
@@ -39,18 +48,14 @@ public:
 
     void update(float dt) override {
         if(!_active||!_bowlSprite)return;
-        _phaseTimer+=dt;
-        if(strcmp(_phase,"lowering")==0){
+        bool entered=_tickPhases(dt);
+        if(_inPhase(Phase::Lowering)){
             _bowlYProg=min(1.0f,_phaseTimer/0.5f);
-            if(_bowlYProg>=1.0f){_phase="pre_eating";_phaseTimer=0;if(_character)_character->setPose("leaning_forward.side.neutral");}
-        } else if(strcmp(_phase,"pre_eating")==0){
-            if(_phaseTimer>=1.5f){_phase="eating";_phaseTimer=0;if(_character)_character->setPose("leaning_forward.side.eating");}
-        } else if(strcmp(_phase,"eating")==0){
-            int nf=_bowlSprite->frame_count;
+        } else if(entered&&_inPhase(Phase::PreEating)){
+            _bowlYProg=1.0f;
+        } else if(!entered&&_inPhase(Phase::Eating)){
             _bowlFrame+=dt*0.4f;
-            if(_bowlFrame>=nf){_phase="post_eating";_phaseTimer=0;if(_character)_character->setPose("leaning_forward.side.neutral");}
-        } else if(strcmp(_phase,"post_eating")==0){
-            if(_phaseTimer>=1.5f) stop(true);
+            if(_bowlFrame>=_bowlSprite->frame_count) _enterPhase(Phase::PostEating);
         }
     }
 
@@ -77,8 +82,8 @@ private:
     void _applyMealStats() {
         GameContext* ctx=_getContext();
         if(!ctx||!_mealType)return;
-        if(strcmp(_mealType,"chicken")==0){ ctx->addStat("fullness",30); ctx->addStat("energy",10); }
-        else if(strcmp(_mealType,"fish")==0){ ctx->addStat("fullness",25); ctx->addStat("affection",5); }
-        else { ctx->addStat("fullness",20); }
+        if(strcmp(_mealType,"chicken")==0){ ctx->addStat(StatId::Fullness,30); ctx->addStat(StatId::Energy,10); }
+        else if(strcmp(_mealType,"fish")==0){ ctx->addStat(StatId::Fullness,25); ctx->addStat(StatId::Affection,5); }
+        else { ctx->addStat(StatId::Fullness,20); }
     }
 };
@@ -5,18 +5,17 @@
 class IdleBehavior : public BaseBehavior {
 public:
     IdleBehavior(CharacterEntity* c) : BaseBehavior(c),
-        _timeUntilPoseChange(0.0f), _currentIdlePose(nullptr) {}
+        _timeUntilPoseChange(0.0f), _currentIdlePose(PoseId::None) {}
 
     const char* name() const override { return "idle"; }
-    int         priority() const override { return 100; }
 
+    static const float      CHECK_INTERVAL;   // s between behavior checks
     static const StatEffect FX[4];
     const StatEffect* statEffects(int* n) const override { *n=4; return FX; }
 
     void start(CompleteCb cb=nullptr, void* ud=nullptr) override {
         if (_active) return;
         BaseBehavior::start(cb, ud);
-        _phase = "idling";
         _pickNewPose();
     }
 
@@ -31,12 +30,11 @@ public:
     BaseBehavior* nextBehavior(GameContext* ctx) override;
 
 private:
-    static const float CHECK_INTERVAL;
     float       _timeUntilPoseChange;
-    const char* _currentIdlePose;
+    PoseId      _currentIdlePose;
 
-    static const char* POSES[];
-    static const int   POSE_COUNT;
+    static const PoseId POSES[];
+    static const int    POSE_COUNT;
 
     void _pickNewPose() {
         int idx = random(POSE_COUNT);
@@ -48,20 +46,20 @@ private:
 
 const float IdleBehavior::CHECK_INTERVAL = 15.0f;
 const StatEffect IdleBehavior::FX[] = {
-    {"curiosity",  0.10f},
-    {"energy",    -0.10f},
-    {"fullness",  -0.10f},
-    {"affection", -0.05f},
+    {StatId::Curiosity,  0.10f},
+    {StatId::Energy,    -0.10f},
+    {StatId::Fullness,  -0.10f},
+    {StatId::Affection, -0.05f},
 };
-const char* IdleBehavior::POSES[] = {
-    "sitting.side.neutral",
-    "sitting.side.happy",
-    "sitting.side.aloof",
-    "sitting.forward.neutral",
-    "sitting.forward.happy",
-    "sitting.forward.aloof",
-    "standing.side.neutral",
-    "standing.side.happy",
+const PoseId IdleBehavior::POSES[] = {
+    POSE_SITTING_SIDE_NEUTRAL,
+    POSE_SITTING_SIDE_HAPPY,
+    POSE_SITTING_SIDE_ALOOF,
+    POSE_SITTING_FORWARD_NEUTRAL,
+    POSE_SITTING_FORWARD_HAPPY,
+    POSE_SITTING_FORWARD_ALOOF,
+    POSE_STANDING_SIDE_NEUTRAL,
+    POSE_STANDING_SIDE_HAPPY,
 };
 const int IdleBehavior::POSE_COUNT = 8;
 
@@ -78,57 +76,47 @@ const int IdleBehavior::POSE_COUNT = 8;
 #include "SelfGroomingBehavior.h"
 #include "LoungeingBehavior.h"
 #include "KneadingBehavior.h"
+#include "UtilityScheduler.h"
+
+template <class B>
+static BaseBehavior* makeCandidate(CharacterEntity* c) { return c->makeBehavior<B>(); }
+
+// Behaviors the pet starts on its own.  Listing is all a new autonomous
+// behavior needs besides its TRIGGER, UTILITY and PHASES timeline (which
+// offline catch-up plays it by).
+#define BEHAVIOR_ENTRY(CLS) { CLS::TRIGGER, CLS::UTILITY, makeCandidate<CLS>, behaviorSpan<CLS> }
+static constexpr BehaviorEntry BEHAVIOR_REGISTRY[] = {
+    BEHAVIOR_ENTRY(SleepingBehavior),
+    BEHAVIOR_ENTRY(NappingBehavior),
+    BEHAVIOR_ENTRY(ZoomiesBehavior),
+    BEHAVIOR_ENTRY(VocalizingBehavior),
+    BEHAVIOR_ENTRY(PlayingBehavior),
+    BEHAVIOR_ENTRY(InvestigatingBehavior),
+    BEHAVIOR_ENTRY(ObservingBehavior),
+    BEHAVIOR_ENTRY(SelfGroomingBehavior),
+    BEHAVIOR_ENTRY(StretchingBehavior),
+    BEHAVIOR_ENTRY(LoungeingBehavior),
+};
+#undef BEHAVIOR_ENTRY
+static constexpr int BEHAVIOR_COUNT = sizeof(BEHAVIOR_REGISTRY) / sizeof(BEHAVIOR_REGISTRY[0]);
+
+// Shared by every character: cooldowns and memory belong to the pet
+static inline UtilityScheduler<BEHAVIOR_COUNT>& behaviorScheduler() {
+    static UtilityScheduler<BEHAVIOR_COUNT> s(BEHAVIOR_REGISTRY);
+    return s;
+}
 
 inline BaseBehavior* IdleBehavior::nextBehavior(GameContext* ctx) {
     if (!ctx) return nullptr;
-    // Try all auto-triggerable behaviors
-    BaseBehavior* candidates[16];
-    int           prio[16];
-    int           count = 0;
-    CharacterEntity* ch = _character;
-
-    #define TRY(CLS) { \
-        CLS* b = new CLS(ch); \
-        if (b->canTrigger(ctx)) { candidates[count]=b; prio[count]=b->priority(); count++; } \
-        else delete b; \
-    }
-    TRY(SleepingBehavior)
-    TRY(NappingBehavior)
-    TRY(ZoomiesBehavior)
-    TRY(VocalizingBehavior)
-    TRY(PlayingBehavior)
-    TRY(InvestigatingBehavior)
-    TRY(ObservingBehavior)
-    TRY(SelfGroomingBehavior)
-    TRY(StretchingBehavior)
-    TRY(LoungeingBehavior)
-    #undef TRY
-
-    if (count == 0) return nullptr;
-
-    // Find minimum priority (highest importance)
-    int best = prio[0];
-    for (int i = 1; i < count; i++) if (prio[i] < best) best = prio[i];
-
-    // Collect all with best priority
-    BaseBehavior* top[16]; int topCount = 0;
-    for (int i = 0; i < count; i++) {
-        if (prio[i] == best) top[topCount++] = candidates[i];
-        else delete candidates[i];
-    }
-
-    // Pick randomly from the top candidates
-    int chosen = random(topCount);
-    BaseBehavior* result = top[chosen];
-    for (int i = 0; i < topCount; i++) if (i != chosen) delete top[i];
-    return result;
+    int i = behaviorScheduler().pick(ctx->stats, millis());
+    return i < 0 ? nullptr : BEHAVIOR_REGISTRY[i].make(_character);
 }
 
 inline BaseBehavior* SleepingBehavior::nextBehavior(GameContext*) {
-    return new StretchingBehavior(_character);
+    return _character->makeBehavior<StretchingBehavior>();
 }
 inline BaseBehavior* StretchingBehavior::nextBehavior(GameContext*) {
-    if (random(100) < 20) return new KneadingBehavior(_character);
+    if (random(100) < KNEAD_CHANCE) return _character->makeBehavior<KneadingBehavior>();
     return nullptr; // -> idle
 }
 inline BaseBehavior* KneadingBehavior::nextBehavior(GameContext*) {
@@ -1,38 +1,27 @@
 #pragma once
 #include "BaseBehavior.h"
 
-class InvestigatingBehavior : public BaseBehavior {
+enum class InvestigatingPhase : uint8_t { Approaching, Sniffing, Reacting, Done };
+
+class InvestigatingBehavior : public PhasedBehavior<InvestigatingPhase> {
 public:
-    InvestigatingBehavior(CharacterEntity* c) : BaseBehavior(c) {}
+    using Phase = InvestigatingPhase;
+    InvestigatingBehavior(CharacterEntity* c) : PhasedBehavior(c, PHASES) {}
     const char* name() const override { return "investigating"; }
-    const char* triggerStat() const override { return "curiosity"; }
-    float triggerThreshold() const override { return 70.0f; }
-    bool  triggerBelow()     const override { return false; }
-    int   priority()         const override { return 40; }
+    static constexpr TriggerSpec TRIGGER = { 1, { statAbove(StatId::Curiosity, 70.0f) } };
+    static constexpr UtilitySpec UTILITY = { 0.6f, 30.0f, 1, { statSurplus(StatId::Curiosity, 0.6f) } };
+
+    static constexpr Step PHASES[] = {
+        { Phase::Approaching,  1.5f, POSE_STANDING_SIDE_NEUTRAL,        Phase::Sniffing, false },
+        { Phase::Sniffing,     4.0f, POSE_LEANING_FORWARD_SIDE_NEUTRAL, Phase::Reacting, false },
+        { Phase::Reacting,     1.5f, POSE_SITTING_SIDE_HAPPY,           Phase::Done,     false },
+    };
+    static_assert(phaseTableValid(PHASES), "PHASES out of order");
 
     static const StatEffect FX[1];
     static const StatEffect BONUS[2];
     const StatEffect* statEffects(int* n) const override { *n=1; return FX; }
     const StatEffect* completionBonus(int* n) const override { *n=2; return BONUS; }
-
-    void start(CompleteCb cb=nullptr,void* ud=nullptr) override {
-        if(_active)return;
-        BaseBehavior::start(cb,ud);
-        _phase="approaching";
-        if(_character) _character->setPose("standing.side.neutral");
-    }
-
-    void update(float dt) override {
-        if(!_active)return;
-        _phaseTimer+=dt;
-        if(strcmp(_phase,"approaching")==0){
-            if(_phaseTimer>=1.5f){_phase="sniffing";_phaseTimer=0;if(_character)_character->setPose("leaning_forward.side.neutral");}
-        } else if(strcmp(_phase,"sniffing")==0){
-            if(_phaseTimer>=4.0f){_phase="reacting";_phaseTimer=0;if(_character)_character->setPose("sitting.side.happy");}
-        } else if(strcmp(_phase,"reacting")==0){
-            if(_phaseTimer>=1.5f) stop(true);
-        }
-    }
 };
-const StatEffect InvestigatingBehavior::FX[]    = {{"curiosity",-1.0f}};
-const StatEffect InvestigatingBehavior::BONUS[] = {{"curiosity",-20.0f},{"fulfillment",5.0f}};
+const StatEffect InvestigatingBehavior::FX[]    = {{StatId::Curiosity,-1.0f}};
+const StatEffect InvestigatingBehavior::BONUS[] = {{StatId::Curiosity,-20.0f},{StatId::Fulfillment,5.0f}};
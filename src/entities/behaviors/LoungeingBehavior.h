@@ -1,35 +1,31 @@
 #pragma once
 #include "BaseBehavior.h"
 
-class LoungeingBehavior : public BaseBehavior {
+enum class LoungeingPhase : uint8_t { Settling, Lounging, Rousing, Done };
+
+class LoungeingBehavior : public PhasedBehavior<LoungeingPhase> {
 public:
-    LoungeingBehavior(CharacterEntity* c) : BaseBehavior(c) {}
+    using Phase = LoungeingPhase;
+    LoungeingBehavior(CharacterEntity* c) : PhasedBehavior(c, PHASES) {}
     const char* name() const override { return "lounging"; }
-    int   priority() const override { return 90; }
-    bool  canTrigger(GameContext*) const override { return true; }
+    static constexpr TriggerSpec TRIGGER = { 0, {} };
+    static constexpr UtilitySpec UTILITY = { 0.1f, 0.0f, 2, { statNeed(StatId::Energy, 0.2f), statSurplus(StatId::Comfort, 0.2f) } };
+
+    static constexpr Step PHASES[] = {
+        { Phase::Settling,  1.0f, PoseId::None, Phase::Lounging, false },
+        { Phase::Lounging, 20.0f, PoseId::None, Phase::Rousing,  true  },
+        { Phase::Rousing,   1.5f, PoseId::None, Phase::Done,     false },
+    };
+    static_assert(phaseTableValid(PHASES), "PHASES out of order");
 
     static const StatEffect FX[2];
     const StatEffect* statEffects(int* n) const override { *n=2; return FX; }
 
     void start(CompleteCb cb=nullptr,void* ud=nullptr) override {
         if(_active)return;
-        BaseBehavior::start(cb,ud);
-        _phase="settling";
-        static const char* poses[]={"sleeping.side.sploot","sitting.side.aloof"};
-        if(_character) _character->setPose(poses[random(2)]);
-    }
-
-    void update(float dt) override {
-        if(!_active)return;
-        _phaseTimer+=dt;
-        if(strcmp(_phase,"settling")==0){
-            if(_phaseTimer>=1.0f){_phase="lounging";_phaseTimer=0;}
-        } else if(strcmp(_phase,"lounging")==0){
-            _progress=min(1.0f,_phaseTimer/20.0f);
-            if(_phaseTimer>=20.0f){_phase="rousing";_phaseTimer=0;}
-        } else if(strcmp(_phase,"rousing")==0){
-            if(_phaseTimer>=1.5f) stop(true);
-        }
+        PhasedBehavior::start(cb,ud);
+        static constexpr PoseId poses[]={POSE_SLEEPING_SIDE_SPLOOT,POSE_SITTING_SIDE_ALOOF};
+        _setPose(poses[random(2)]);
     }
 };
-const StatEffect LoungeingBehavior::FX[] = {{"comfort",-0.1f},{"energy",-0.05f}};
+const StatEffect LoungeingBehavior::FX[] = {{StatId::Comfort,-0.1f},{StatId::Energy,-0.05f}};
@@ -1,14 +1,22 @@
 #pragma once
 #include "BaseBehavior.h"
 
-class PlayingBehavior : public BaseBehavior {
+enum class PlayingPhase : uint8_t { Excited, Playing, Tired, Done };
+
+class PlayingBehavior : public PhasedBehavior<PlayingPhase> {
 public:
-    PlayingBehavior(CharacterEntity* c) : BaseBehavior(c), _bubble(nullptr) {}
+    using Phase = PlayingPhase;
+    PlayingBehavior(CharacterEntity* c) : PhasedBehavior(c, PHASES), _bubble(nullptr) {}
     const char* name() const override { return "playing"; }
-    const char* triggerStat() const override { return "playfulness"; }
-    float triggerThreshold() const override { return 70.0f; }
-    bool  triggerBelow()     const override { return false; }
-    int   priority()         const override { return 30; }
+    static constexpr TriggerSpec TRIGGER = { 1, { statAbove(StatId::Playfulness, 70.0f) } };
+    static constexpr UtilitySpec UTILITY = { 0.7f, 30.0f, 1, { statSurplus(StatId::Playfulness, 0.6f) } };
+
+    static constexpr Step PHASES[] = {
+        { Phase::Excited, 1.0f, POSE_SITTING_SIDE_HAPPY,   Phase::Playing, false },
+        { Phase::Playing, 5.0f, POSE_STANDING_SIDE_HAPPY,  Phase::Tired,   true  },
+        { Phase::Tired,   1.0f, POSE_SITTING_SIDE_NEUTRAL, Phase::Done,    false },
+    };
+    static_assert(phaseTableValid(PHASES), "PHASES out of order");
 
     static const StatEffect FX[2];
     static const StatEffect BONUS[2];
@@ -17,38 +25,23 @@ public:
 
     void start(const char* trigger=nullptr, CompleteCb cb=nullptr, void* ud=nullptr) {
         if(_active)return;
-        BaseBehavior::start(cb,ud);
-        _phase="excited";
+        PhasedBehavior::start(cb,ud);
         _bubble=nullptr;
-        if(_character) _character->setPose("sitting.side.happy");
         if(trigger&&_character&&_character->context){
             _bubble="!";
-            _character->context->addStat("playfulness",15.0f);
-            _character->context->addStat("energy",-5.0f);
+            _character->context->addStat(StatId::Playfulness,15.0f);
+            _character->context->addStat(StatId::Energy,-5.0f);
         }
     }
     void start(CompleteCb cb=nullptr,void* ud=nullptr) override { start(nullptr,cb,ud); }
 
-    void update(float dt) override {
-        if(!_active)return;
-        _phaseTimer+=dt;
-        if(strcmp(_phase,"excited")==0){
-            if(_phaseTimer>=1.0f){_phase="playing";_phaseTimer=0;_bubble=nullptr;if(_character)_character->setPose("standing.side.happy");}
-        } else if(strcmp(_phase,"playing")==0){
-            _progress=min(1.0f,_phaseTimer/5.0f);
-            if(_phaseTimer>=5.0f){_phase="tired";_phaseTimer=0;if(_character)_character->setPose("sitting.side.neutral");}
-        } else if(strcmp(_phase,"tired")==0){
-            if(_phaseTimer>=1.0f) stop(true);
-        }
-    }
-
     void draw(Renderer& r, int cx, int cy, bool mirror) override {
-        if(!_active||!_bubble||strcmp(_phase,"excited")!=0)return;
+        if(!_active||!_bubble||!_inPhase(Phase::Excited))return;
         r.drawText(_bubble,cx+(mirror?10:-12),cy-28,COLOR_YELLOW,COLOR_BLACK,1);
     }
 
 private:
     const char* _bubble;
 };
-const StatEffect PlayingBehavior::FX[]    = {{"playfulness",-2.0f},{"energy",-0.5f}};
-const StatEffect PlayingBehavior::BONUS[] = {{"playfulness",-25.0f},{"fulfillment",10.0f}};
+const StatEffect PlayingBehavior::FX[]    = {{StatId::Playfulness,-2.0f},{StatId::Energy,-0.5f}};
+const StatEffect PlayingBehavior::BONUS[] = {{StatId::Playfulness,-25.0f},{StatId::Fulfillment,10.0f}};
@@ -1,41 +1,27 @@
 #pragma once
 #include "BaseBehavior.h"
 
-class SelfGroomingBehavior : public BaseBehavior {
+enum class SelfGroomingPhase : uint8_t { Preparing, Grooming, Finishing, Done };
+
+class SelfGroomingBehavior : public PhasedBehavior<SelfGroomingPhase> {
 public:
-    SelfGroomingBehavior(CharacterEntity* c) : BaseBehavior(c) {}
+    using Phase = SelfGroomingPhase;
+    SelfGroomingBehavior(CharacterEntity* c) : PhasedBehavior(c, PHASES) {}
     const char* name() const override { return "self_grooming"; }
-    int   priority() const override { return 45; }
+    static constexpr TriggerSpec TRIGGER = { 2, { statBelow(StatId::Cleanliness, 40.0f), statAbove(StatId::Energy, 30.0f) } };
+    static constexpr UtilitySpec UTILITY = { 0.55f, 60.0f, 1, { statNeed(StatId::Cleanliness, 1.0f) } };
 
-    bool canTrigger(GameContext* ctx) const override {
-        if(!ctx)return false;
-        return ctx->getStat("cleanliness")<40.0f && ctx->getStat("energy")>30.0f;
-    }
+    static constexpr Step PHASES[] = {
+        { Phase::Preparing,  1.0f, POSE_SITTING_FORWARD_NEUTRAL, Phase::Grooming,  false },
+        { Phase::Grooming,  12.0f, POSE_SITTING_SIDE_ALOOF,      Phase::Finishing, true  },
+        { Phase::Finishing,  1.5f, POSE_SITTING_SIDE_HAPPY,      Phase::Done,      false },
+    };
+    static_assert(phaseTableValid(PHASES), "PHASES out of order");
 
     static const StatEffect FX[4];
     static const StatEffect BONUS[4];
     const StatEffect* statEffects(int* n) const override { *n=4; return FX; }
     const StatEffect* completionBonus(int* n) const override { *n=4; return BONUS; }
-
-    void start(CompleteCb cb=nullptr,void* ud=nullptr) override {
-        if(_active)return;
-        BaseBehavior::start(cb,ud);
-        _phase="preparing";
-        if(_character) _character->setPose("sitting.forward.neutral");
-    }
-
-    void update(float dt) override {
-        if(!_active)return;
-        _phaseTimer+=dt;
-        if(strcmp(_phase,"preparing")==0){
-            if(_phaseTimer>=1.0f){_phase="grooming";_phaseTimer=0;if(_character)_character->setPose("sitting.side.aloof");}
-        } else if(strcmp(_phase,"grooming")==0){
-            _progress=min(1.0f,_phaseTimer/12.0f);
-            if(_phaseTimer>=12.0f){_phase="finishing";_phaseTimer=0;if(_character)_character->setPose("sitting.side.happy");}
-        } else if(strcmp(_phase,"finishing")==0){
-            if(_phaseTimer>=1.5f) stop(true);
-        }
-    }
 };
-const StatEffect SelfGroomingBehavior::FX[]    = {{"cleanliness",0.5f},{"energy",-0.2f},{"comfort",-0.1f},{"focus",-0.2f}};
-const StatEffect SelfGroomingBehavior::BONUS[] = {{"cleanliness",15.0f},{"grace",5.0f},{"sociability",3.0f},{"affection",2.0f}};
+const StatEffect SelfGroomingBehavior::FX[]    = {{StatId::Cleanliness,0.5f},{StatId::Energy,-0.2f},{StatId::Comfort,-0.1f},{StatId::Focus,-0.2f}};
+const StatEffect SelfGroomingBehavior::BONUS[] = {{StatId::Cleanliness,15.0f},{StatId::Grace,5.0f},{StatId::Sociability,3.0f},{StatId::Affection,2.0f}};
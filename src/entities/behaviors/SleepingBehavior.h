@@ -2,14 +2,23 @@
 #include "BaseBehavior.h"
 #include <math.h>
 
-class SleepingBehavior : public BaseBehavior {
+enum class SleepingPhase : uint8_t { Considering, Settling, Sleeping, Waking, Done };
+
+class SleepingBehavior : public PhasedBehavior<SleepingPhase> {
 public:
-    SleepingBehavior(CharacterEntity* c) : BaseBehavior(c), _sleepPose(nullptr) {}
+    using Phase = SleepingPhase;
+    SleepingBehavior(CharacterEntity* c) : PhasedBehavior(c, PHASES), _sleepPose(PoseId::None) {}
     const char* name() const override { return "sleeping"; }
-    const char* triggerStat() const override { return "energy"; }
-    float triggerThreshold() const override { return 30.0f; }
-    bool  triggerBelow()     const override { return true; }
-    int   priority()         const override { return 10; }
+    static constexpr TriggerSpec TRIGGER = { 1, { statBelow(StatId::Energy, 30.0f) } };
+    static constexpr UtilitySpec UTILITY = { 0.9f, 0.0f, 1, { statNeed(StatId::Energy, 2.0f) } };
+
+    static constexpr Step PHASES[] = {
+        { Phase::Considering,  1.0f, POSE_SITTING_SIDE_LOOKING_DOWN,    Phase::Settling, false },
+        { Phase::Settling,     2.5f, POSE_LEANING_FORWARD_SIDE_NEUTRAL, Phase::Sleeping, false },
+        { Phase::Sleeping,    45.0f, PoseId::None,                      Phase::Waking,   true  },   // pose picked in start()
+        { Phase::Waking,       5.0f, PoseId::None,                      Phase::Done,     false },
+    };
+    static_assert(phaseTableValid(PHASES), "PHASES out of order");
 
     static const StatEffect FX[2];
     static const StatEffect BONUS[2];
@@ -18,30 +27,18 @@ public:
 
     void start(CompleteCb cb=nullptr,void* ud=nullptr) override {
         if(_active)return;
-        BaseBehavior::start(cb,ud);
-        static const char* poses[]={"sleeping.side.sploot","sleeping.side.modest","sleeping.side.crossed"};
+        static constexpr PoseId poses[]={POSE_SLEEPING_SIDE_SPLOOT,POSE_SLEEPING_SIDE_MODEST,POSE_SLEEPING_SIDE_CROSSED};
         _sleepPose=poses[random(3)];
-        _phase="considering";
-        if(_character) _character->setPose("sitting.side.looking_down");
+        PhasedBehavior::start(cb,ud);
     }
 
     void update(float dt) override {
         if(!_active)return;
-        _phaseTimer+=dt;
-        if(strcmp(_phase,"considering")==0){
-            if(_phaseTimer>=1.0f){_phase="settling";_phaseTimer=0;if(_character)_character->setPose("leaning_forward.side.neutral");}
-        } else if(strcmp(_phase,"settling")==0){
-            if(_phaseTimer>=2.5f){_phase="sleeping";_phaseTimer=0;if(_character)_character->setPose(_sleepPose);}
-        } else if(strcmp(_phase,"sleeping")==0){
-            _progress=min(1.0f,_phaseTimer/45.0f);
-            if(_phaseTimer>=45.0f){_phase="waking";_phaseTimer=0;}
-        } else if(strcmp(_phase,"waking")==0){
-            if(_phaseTimer>=5.0f) stop(true);
-        }
+        if(_tickPhases(dt) && _inPhase(Phase::Sleeping)) _setPose(_sleepPose);
     }
 
     void draw(Renderer& r, int cx, int cy, bool mirror) override {
-        if(!_active || strcmp(_phase,"sleeping")!=0) return;
+        if(!_active || !_inPhase(Phase::Sleeping)) return;
         for(int i=0;i<4;i++){
             float wave=sin(_phaseTimer*3.0f - i*0.8f)*3.0f;
             int zx=cx+(mirror?20:-20)+i*8;
@@ -54,7 +51,7 @@ public:
     BaseBehavior* nextBehavior(GameContext*) override;
 
 private:
-    const char* _sleepPose;
+    PoseId _sleepPose;
 };
-const StatEffect SleepingBehavior::FX[]    = {{"energy",2.0f},{"comfort",0.2f}};
-const StatEffect SleepingBehavior::BONUS[] = {{"energy",15.0f},{"comfort",10.0f}};
+const StatEffect SleepingBehavior::FX[]    = {{StatId::Energy,2.0f},{StatId::Comfort,0.2f}};
+const StatEffect SleepingBehavior::BONUS[] = {{StatId::Energy,15.0f},{StatId::Comfort,10.0f}};
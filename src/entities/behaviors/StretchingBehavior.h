@@ -1,40 +1,31 @@
 #pragma once
 #include "BaseBehavior.h"
 
-class StretchingBehavior : public BaseBehavior {
+enum class StretchingPhase : uint8_t { Preparing, Stretching, Relaxing, Done };
+
+class StretchingBehavior : public PhasedBehavior<StretchingPhase> {
 public:
-    StretchingBehavior(CharacterEntity* c) : BaseBehavior(c) {}
+    using Phase = StretchingPhase;
+    StretchingBehavior(CharacterEntity* c) : PhasedBehavior(c, PHASES) {}
     const char* name() const override { return "stretching"; }
-    const char* triggerStat() const override { return "comfort"; }
-    float triggerThreshold() const override { return 40.0f; }
-    bool  triggerBelow()     const override { return true; }
-    int   priority()         const override { return 50; }
+    static constexpr TriggerSpec TRIGGER = { 1, { statBelow(StatId::Comfort, 40.0f) } };
+    static constexpr UtilitySpec UTILITY = { 0.5f, 60.0f, 1, { statNeed(StatId::Comfort, 0.6f) } };
+
+    static constexpr Step PHASES[] = {
+        { Phase::Preparing,   0.5f, POSE_STANDING_SIDE_NEUTRAL,        Phase::Stretching, false },
+        { Phase::Stretching,  3.0f, POSE_LEANING_FORWARD_SIDE_NEUTRAL, Phase::Relaxing,   false },
+        { Phase::Relaxing,    1.5f, POSE_SITTING_SIDE_HAPPY,           Phase::Done,       false },
+    };
+    static_assert(phaseTableValid(PHASES), "PHASES out of order");
+
+    static constexpr int KNEAD_CHANCE = 20;   // % of stretches that run on into kneading
 
     static const StatEffect FX[1];
     static const StatEffect BONUS[1];
     const StatEffect* statEffects(int* n) const override { *n=1; return FX; }
     const StatEffect* completionBonus(int* n) const override { *n=1; return BONUS; }
 
-    void start(CompleteCb cb=nullptr,void* ud=nullptr) override {
-        if(_active)return;
-        BaseBehavior::start(cb,ud);
-        _phase="preparing";
-        if(_character) _character->setPose("standing.side.neutral");
-    }
-
-    void update(float dt) override {
-        if(!_active)return;
-        _phaseTimer+=dt;
-        if(strcmp(_phase,"preparing")==0){
-            if(_phaseTimer>=0.5f){_phase="stretching";_phaseTimer=0;if(_character)_character->setPose("leaning_forward.side.neutral");}
-        } else if(strcmp(_phase,"stretching")==0){
-            if(_phaseTimer>=3.0f){_phase="relaxing";_phaseTimer=0;if(_character)_character->setPose("sitting.side.happy");}
-        } else if(strcmp(_phase,"relaxing")==0){
-            if(_phaseTimer>=1.5f) stop(true);
-        }
-    }
-
     BaseBehavior* nextBehavior(GameContext*) override;
 };
-const StatEffect StretchingBehavior::FX[]    = {{"comfort",1.5f}};
-const StatEffect StretchingBehavior::BONUS[] = {{"comfort",15.0f}};
+const StatEffect StretchingBehavior::FX[]    = {{StatId::Comfort,1.5f}};
+const StatEffect StretchingBehavior::BONUS[] = {{StatId::Comfort,15.0f}};
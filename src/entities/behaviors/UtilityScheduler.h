@@ -0,0 +1,148 @@
+#pragma once
+// UtilityScheduler.h - Picks the next autonomous behavior by utility score
+//
+// A behavior scores its UTILITY base plus, per term, weight * curve(stat).
+// Each pick evaluates both curves for every stat once, into a feature
+// vector (Need values, then Surplus values, STAT_LANES each).  The weights
+// sit in a feature-major matrix with one column per behavior, so scoring is
+// multiply-adds along rows of behaviors, four columns at a time, which
+// vectorizes.  Behaviors weight a few stats each, so most of the matrix is
+// zero: each row keeps a list of its 4-column blocks holding any weight and
+// only those are visited.
+//
+// A behavior whose TRIGGER doesn't hold, or that was picked less than its
+// cooldown ago, is out.  Cooldowns compare the time since the last pick, so
+// they keep working when millis() passes 2^31 or wraps.  Each time it appears
+// in the last UTILITY_MEMORY picks costs it UTILITY_REPEAT_PENALTY.  The pick
+// is random among those within UTILITY_TIE_BAND of the best score.
+
+#include <Arduino.h>
+#include <math.h>
+#include "config.h"
+#include "BaseBehavior.h"
+
+struct BehaviorEntry {
+    TriggerSpec   trigger;
+    UtilitySpec   utility;
+    BaseBehavior* (*make)(CharacterEntity*);
+    BehaviorSpan  (*span)();   // one run, for offline catch-up
+};
+
+static const int UTILITY_FEATURES = 2 * STAT_LANES;
+
+static inline int utilityFeature(const UtilityTerm& t) {
+    return (t.curve == UtilityCurve::Need ? 0 : STAT_LANES) + (int)t.stat;
+}
+
+// Both curves of every stat lane; f holds UTILITY_FEATURES floats
+static inline void utilityFeatures(const float* __restrict stats, float* __restrict f) {
+    for (int i = 0; i < STAT_LANES; i++) {
+        float x = stats[i] * 0.01f;
+        f[i]              = (1.0f - x) * (1.0f - x);
+        f[STAT_LANES + i] = x * x;
+    }
+}
+
+template <int N>
+class UtilityScheduler {
+public:
+    static constexpr int LANES = (N + 3) & ~3;   // columns, padded like stats
+
+    explicit UtilityScheduler(const BehaviorEntry* entries)
+        : _entries(entries), _rowCount(0) {
+        memset(_w, 0, sizeof(_w));
+        memset(_base, 0, sizeof(_base));
+        reset();
+        for (int b = 0; b < N; b++) {
+            const UtilitySpec& u = entries[b].utility;
+            _base[b] = u.base;
+            _cooldownMs[b] = (uint32_t)(u.cooldownS * 1000.0f);
+            for (int t = 0; t < u.termCount; t++) _w[utilityFeature(u.term[t])][b] += u.term[t].weight;
+        }
+        int k = 0;
+        for (int f = 0; f < UTILITY_FEATURES; f++) {
+            int first = k;
+            for (int q = 0; q < LANES / 4; q++) {
+                const float* w = &_w[f][q * 4];
+                if (w[0] != 0.0f || w[1] != 0.0f || w[2] != 0.0f || w[3] != 0.0f) _blocks[k++] = (uint16_t)q;
+            }
+            if (k == first) continue;
+            _rows[_rowCount]     = (uint8_t)f;
+            _rowStart[_rowCount] = (uint16_t)first;
+            _rowCount++;
+        }
+        _rowStart[_rowCount] = (uint16_t)k;
+    }
+
+    // Forget every pick: no cooldowns running, nothing remembered
+    void reset() {
+        memset(_pickedAt, 0, sizeof(_pickedAt));
+        memset(_cooling, 0, sizeof(_cooling));
+        memset(_recent, 0, sizeof(_recent));
+        for (int i = 0; i < UTILITY_MEMORY; i++) _memory[i] = -1;
+        _memPos = 0;
+    }
+
+    // Utility of every behavior, before eligibility and penalties; out holds
+    // LANES floats
+    void score(const float* stats, float* __restrict out) const {
+        alignas(16) float f[UTILITY_FEATURES];
+        utilityFeatures(stats, f);
+        for (int b = 0; b < LANES; b++) out[b] = _base[b];
+        for (int r = 0; r < _rowCount; r++) {
+            const float  x   = f[_rows[r]];
+            const float* row = _w[_rows[r]];
+            for (int k = _rowStart[r]; k < _rowStart[r + 1]; k++) {
+                const float* __restrict w = row + _blocks[k] * 4;
+                float*       __restrict o = out + _blocks[k] * 4;
+                o[0] += w[0] * x; o[1] += w[1] * x; o[2] += w[2] * x; o[3] += w[3] * x;
+            }
+        }
+    }
+
+    // Index of the behavior to start, or -1 if none can; nowMs is millis()
+    int pick(const float* stats, uint32_t nowMs) {
+        alignas(16) float s[LANES];
+        score(stats, s);
+
+        float best = -INFINITY;
+        for (int b = 0; b < N; b++) {
+            if (_cooling[b] && nowMs - _pickedAt[b] >= _cooldownMs[b]) _cooling[b] = false;
+            if (_cooling[b] || !_entries[b].trigger.eligible(stats)) {
+                s[b] = -INFINITY;
+                continue;
+            }
+            s[b] -= UTILITY_REPEAT_PENALTY * _recent[b];
+            if (s[b] > best) best = s[b];
+        }
+        if (best == -INFINITY) return -1;
+
+        int top[N], topCount = 0;
+        for (int b = 0; b < N; b++)
+            if (s[b] >= best - UTILITY_TIE_BAND) top[topCount++] = b;
+        int chosen = top[random(topCount)];
+
+        _pickedAt[chosen] = nowMs;
+        _cooling[chosen]  = _cooldownMs[chosen] > 0;
+        if (_memory[_memPos] >= 0) _recent[_memory[_memPos]]--;
+        _memory[_memPos] = chosen;
+        _recent[chosen]++;
+        _memPos = (_memPos + 1) % UTILITY_MEMORY;
+        return chosen;
+    }
+
+private:
+    const BehaviorEntry* _entries;
+    alignas(16) float    _w[UTILITY_FEATURES][LANES];
+    alignas(16) float    _base[LANES];
+    uint8_t              _rows[UTILITY_FEATURES];   // features with any weight
+    int                  _rowCount;
+    uint16_t             _rowStart[UTILITY_FEATURES + 1];      // into _blocks
+    uint16_t             _blocks[UTILITY_FEATURES * LANES / 4]; // nonzero 4-column blocks
+    uint32_t             _pickedAt[N];              // millis() of the last pick
+    uint32_t             _cooldownMs[N];
+    bool                 _cooling[N];               // picked, cooldown not yet over
+    uint8_t              _recent[N];                // appearances in _memory
+    int                  _memory[UTILITY_MEMORY];   // last picks, -1 = empty
+    int                  _memPos;
+};
@@ -1,45 +1,32 @@
 #pragma once
 #include "BaseBehavior.h"
 
-class VocalizingBehavior : public BaseBehavior {
+enum class VocalizingPhase : uint8_t { WindingUp, Vocalizing, Settling, Done };
+
+class VocalizingBehavior : public PhasedBehavior<VocalizingPhase> {
 public:
-    VocalizingBehavior(CharacterEntity* c) : BaseBehavior(c) {}
+    using Phase = VocalizingPhase;
+    VocalizingBehavior(CharacterEntity* c) : PhasedBehavior(c, PHASES) {}
     const char* name() const override { return "vocalizing"; }
-    int   priority() const override { return 25; }
+    static constexpr TriggerSpec TRIGGER = { 2, { statAbove(StatId::Energy, 60.0f), statAbove(StatId::Playfulness, 60.0f) } };
+    static constexpr UtilitySpec UTILITY = { 0.75f, 60.0f, 2, { statSurplus(StatId::Playfulness, 0.3f), statNeed(StatId::Affection, 0.5f) } };
 
-    bool canTrigger(GameContext* ctx) const override {
-        if(!ctx)return false;
-        return ctx->getStat("energy")>60.0f && ctx->getStat("playfulness")>60.0f;
-    }
+    static constexpr Step PHASES[] = {
+        { Phase::WindingUp,   0.5f, POSE_SITTING_FORWARD_ALOOF, Phase::Vocalizing, false },
+        { Phase::Vocalizing,  4.0f, POSE_SITTING_FORWARD_HAPPY, Phase::Settling,   false },
+        { Phase::Settling,    1.0f, POSE_SITTING_SIDE_NEUTRAL,  Phase::Done,       false },
+    };
+    static_assert(phaseTableValid(PHASES), "PHASES out of order");
 
     static const StatEffect FX[2];
     static const StatEffect BONUS[2];
     const StatEffect* statEffects(int* n) const override { *n=2; return FX; }
     const StatEffect* completionBonus(int* n) const override { *n=2; return BONUS; }
 
-    void start(CompleteCb cb=nullptr,void* ud=nullptr) override {
-        if(_active)return;
-        BaseBehavior::start(cb,ud);
-        _phase="winding_up";
-        if(_character) _character->setPose("sitting.forward.aloof");
-    }
-
-    void update(float dt) override {
-        if(!_active)return;
-        _phaseTimer+=dt;
-        if(strcmp(_phase,"winding_up")==0){
-            if(_phaseTimer>=0.5f){_phase="vocalizing";_phaseTimer=0;if(_character)_character->setPose("sitting.forward.happy");}
-        } else if(strcmp(_phase,"vocalizing")==0){
-            if(_phaseTimer>=4.0f){_phase="settling";_phaseTimer=0;if(_character)_character->setPose("sitting.side.neutral");}
-        } else if(strcmp(_phase,"settling")==0){
-            if(_phaseTimer>=1.0f) stop(true);
-        }
-    }
-
     void draw(Renderer& r, int cx, int cy, bool mirror) override {
-        if(!_active||strcmp(_phase,"vocalizing")!=0)return;
+        if(!_active||!_inPhase(Phase::Vocalizing))return;
         r.drawText("~",cx+(mirror?15:-15),cy-30,COLOR_WHITE,COLOR_BLACK,1);
     }
 };
-const StatEffect VocalizingBehavior::FX[]    = {{"energy",-1.0f},{"playfulness",-1.5f}};
-const StatEffect VocalizingBehavior::BONUS[] = {{"energy",-5.0f},{"playfulness",-8.0f}};
+const StatEffect VocalizingBehavior::FX[]    = {{StatId::Energy,-1.0f},{StatId::Playfulness,-1.5f}};
+const StatEffect VocalizingBehavior::BONUS[] = {{StatId::Energy,-5.0f},{StatId::Playfulness,-8.0f}};
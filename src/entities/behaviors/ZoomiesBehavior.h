@@ -1,15 +1,28 @@
 #pragma once
 #include "BaseBehavior.h"
 
-class ZoomiesBehavior : public BaseBehavior {
+enum class ZoomiesPhase : uint8_t { WindingUp, Zooming, Collapsing, Done };
+
+class ZoomiesBehavior : public PhasedBehavior<ZoomiesPhase> {
 public:
-    ZoomiesBehavior(CharacterEntity* c) : BaseBehavior(c) {}
+    using Phase = ZoomiesPhase;
+    ZoomiesBehavior(CharacterEntity* c) : PhasedBehavior(c, PHASES), _dust(0.0f) {}
     const char* name() const override { return "zoomies"; }
-    int   priority() const override { return 25; }
+    static constexpr TriggerSpec TRIGGER = { 2, { statAbove(StatId::Energy, 70.0f), statAbove(StatId::Playfulness, 70.0f) } };
+    static constexpr UtilitySpec UTILITY = { 0.75f, 120.0f, 2, { statSurplus(StatId::Energy, 0.5f), statSurplus(StatId::Playfulness, 0.5f) } };
+
+    static constexpr Step PHASES[] = {
+        { Phase::WindingUp,   1.0f, POSE_SITTING_SIDE_ALOOF,   Phase::Zooming,    false },
+        { Phase::Zooming,    10.0f, POSE_STANDING_SIDE_HAPPY,  Phase::Collapsing, true  },
+        { Phase::Collapsing,  2.0f, POSE_SITTING_SIDE_NEUTRAL, Phase::Done,       false },
+    };
+    static_assert(phaseTableValid(PHASES), "PHASES out of order");
 
-    bool canTrigger(GameContext* ctx) const override {
-        if(!ctx)return false;
-        return ctx->getStat("energy")>70.0f && ctx->getStat("playfulness")>70.0f;
+    void update(float dt) override {
+        if (!_active) return;
+        _tickPhases(dt);
+        if (_active && _inPhase(Phase::Zooming) && _character->particles)
+            _character->particles->emit(DUST_PUFFS, dt, _dust, _character->x, _character->y);
     }
 
     static const StatEffect FX[2];
@@ -17,25 +30,8 @@ public:
     const StatEffect* statEffects(int* n) const override { *n=2; return FX; }
     const StatEffect* completionBonus(int* n) const override { *n=2; return BONUS; }
 
-    void start(CompleteCb cb=nullptr,void* ud=nullptr) override {
-        if(_active)return;
-        BaseBehavior::start(cb,ud);
-        _phase="winding_up";
-        if(_character) _character->setPose("sitting.side.aloof");
-    }
-
-    void update(float dt) override {
-        if(!_active)return;
-        _phaseTimer+=dt;
-        if(strcmp(_phase,"winding_up")==0){
-            if(_phaseTimer>=1.0f){_phase="zooming";_phaseTimer=0;if(_character)_character->setPose("standing.side.happy");}
-        } else if(strcmp(_phase,"zooming")==0){
-            _progress=min(1.0f,_phaseTimer/10.0f);
-            if(_phaseTimer>=10.0f){_phase="collapsing";_phaseTimer=0;if(_character)_character->setPose("sitting.side.neutral");}
-        } else if(strcmp(_phase,"collapsing")==0){
-            if(_phaseTimer>=2.0f) stop(true);
-        }
-    }
+private:
+    float _dust;   // puffs carried to the next frame
 };
-const StatEffect ZoomiesBehavior::FX[]    = {{"energy",-2.0f},{"playfulness",-3.0f}};
-const StatEffect ZoomiesBehavior::BONUS[] = {{"energy",-10.0f},{"playfulness",-15.0f}};
+const StatEffect ZoomiesBehavior::FX[]    = {{StatId::Energy,-2.0f},{StatId::Playfulness,-3.0f}};
+const StatEffect ZoomiesBehavior::BONUS[] = {{StatId::Energy,-10.0f},{StatId::Playfulness,-15.0f}};
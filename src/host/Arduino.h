@@ -0,0 +1,68 @@
+#pragma once
+// Arduino.h - Host stand-in for the parts of the Arduino core the game uses
+//
+// Native build only (see [env:native] in platformio.ini).  Time is virtual:
+// millis()/micros() read a clock that only delay() moves forward, so the game
+// loop runs as fast as the host allows while scenes still see real frame
+// steps.  random() is a seeded xorshift, so runs are reproducible.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+
+#define PROGMEM
+
+using std::min;
+using std::max;
+
+// ── Virtual clock ──────────────────────────────────────────────────────────
+
+namespace host {
+    inline std::atomic<uint64_t>& clockUs() { static std::atomic<uint64_t> us{0}; return us; }
+    inline void advanceUs(uint64_t us) { clockUs() += us; }
+}
+
+inline uint32_t millis()            { return (uint32_t)(host::clockUs() / 1000); }
+inline uint32_t micros()            { return (uint32_t)host::clockUs(); }
+inline void     delay(uint32_t ms)  { host::advanceUs((uint64_t)ms * 1000); }
+inline void     yield()             {}
+
+// ── Random ─────────────────────────────────────────────────────────────────
+
+namespace host {
+    inline uint32_t& rngState() { static uint32_t s = 1; return s; }
+}
+
+inline void randomSeed(uint32_t seed) { host::rngState() = seed ? seed : 1; }
+
+inline long random(long howbig) {
+    if (howbig <= 0) return 0;
+    uint32_t& x = host::rngState();
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return (long)(x % (uint32_t)howbig);
+}
+inline long random(long howsmall, long howbig) {
+    return howbig <= howsmall ? howsmall : howsmall + random(howbig - howsmall);
+}
+
+// ── Serial (stdout) ────────────────────────────────────────────────────────
+
+struct HostSerial {
+    void   begin(unsigned long) {}
+    size_t write(uint8_t b) { return fputc(b, stdout) == EOF ? 0 : 1; }
+    size_t write(const uint8_t* buf, size_t n) { return fwrite(buf, 1, n, stdout); }
+    size_t print(const char* s) { return fputs(s, stdout) < 0 ? 0 : strlen(s); }
+    size_t println(const char* s = "") { size_t n = print(s); fputc('\n', stdout); return n + 1; }
+    int printf(const char* fmt, ...) {
+        va_list ap; va_start(ap, fmt);
+        int n = vprintf(fmt, ap);
+        va_end(ap);
+        return n;
+    }
+};
+static HostSerial Serial;
@@ -0,0 +1,1203 @@
+#pragma once
+// Bench.h - Deterministic input-replay benchmark for the native build
+//
+// For each scene: switch to it, let the transition settle, then run N
+// simulated minutes of frames.  dt and button presses come from a script
+// generated from the seed (not from the clock), so a given seed always
+// produces the same frames.  Each phase of the frame (update, draw, push) is
+// timed with the host's steady clock, and heap allocations are counted
+// (and live heap bytes tracked) by the allocator replacements below.
+//
+// Included by host_main.cpp after main.cpp; uses its globals directly.
+
+#include <atomic>
+#include <chrono>
+#include <errno.h>
+#include <malloc.h>
+#include <new>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+// ── Allocation counting ────────────────────────────────────────────────────
+
+// Every heap block the process takes, whether from operator new or straight
+// from malloc (the SpriteCache arena, the sky image runs, the frame-diff
+// copy), goes through benchMalloc: malloc and friends are replaced here and
+// forward to glibc's __libc_* entry points.  Sanitizer builds keep their own
+// allocator, so there only operator new is counted.  Counters are atomic
+// because the pipeline check allocates from two threads.
+
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void  __libc_free(void*);
+}
+
+static std::atomic<uint64_t> gBenchAllocs{ 0 };
+static std::atomic<int64_t>  gBenchLiveBytes{ 0 };   // malloc_usable_size of live blocks
+
+static void* benchCounted(void* p) {
+    if (p) {
+        gBenchAllocs++;
+        gBenchLiveBytes += malloc_usable_size(p);
+    }
+    return p;
+}
+static void* benchMalloc(size_t n) { return benchCounted(__libc_malloc(n)); }
+static void  benchFree(void* p) {
+    if (p) gBenchLiveBytes -= malloc_usable_size(p);
+    __libc_free(p);
+}
+
+#if !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+extern "C" {
+void* malloc(size_t n)           { return benchMalloc(n); }
+void* calloc(size_t n, size_t m) { return benchCounted(__libc_calloc(n, m)); }
+void  free(void* p)              { benchFree(p); }
+void* realloc(void* p, size_t n) {
+    if (p) gBenchLiveBytes -= malloc_usable_size(p);
+    void* q = __libc_realloc(p, n);
+    if (!q && p && n) gBenchLiveBytes += malloc_usable_size(p);   // p is still live
+    return benchCounted(q);
+}
+void* memalign(size_t a, size_t n)      { return benchCounted(__libc_memalign(a, n)); }
+void* aligned_alloc(size_t a, size_t n) { return benchCounted(__libc_memalign(a, n)); }
+int   posix_memalign(void** out, size_t a, size_t n) {
+    void* p = benchCounted(__libc_memalign(a, n));
+    if (!p) return ENOMEM;
+    *out = p;
+    return 0;
+}
+}
+#endif
+
+void* operator new(size_t n) {
+    if (void* p = benchMalloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t n) { return operator new(n); }
+void  operator delete(void* p) noexcept           { benchFree(p); }
+void  operator delete[](void* p) noexcept         { benchFree(p); }
+void  operator delete(void* p, size_t) noexcept   { benchFree(p); }
+void  operator delete[](void* p, size_t) noexcept { benchFree(p); }
+
+// ── Input script ───────────────────────────────────────────────────────────
+
+// Button holds chosen from the short / medium / long press windows. BtnB long
+// (back) and BtnPWR (menus) are left out so the run stays in its scene.
+class BenchScript {
+public:
+    explicit BenchScript(uint32_t seed) : _rng(seed * 2654435761u + 1) {}
+
+    // Frame dt in ms: the frame period with a little jitter
+    uint32_t nextDtMs() { return FRAME_TIME_MS + _next() % 5; }
+
+    // Called once per frame with the frame's virtual time
+    void apply(uint32_t nowMs) {
+        if (_held && nowMs >= _releaseAt) {
+            _held->setPressed(false);
+            _held = nullptr;
+            _nextPressAt = nowMs + 400 + _next() % 2000;
+        }
+        if (!_held && nowMs >= _nextPressAt) {
+            static const uint32_t HOLD_MS[] = { 120, 450, 900 };
+            bool a = _next() % 2 == 0;
+            _held  = a ? &M5.BtnA : &M5.BtnB;
+            _held->setPressed(true);
+            _releaseAt = nowMs + HOLD_MS[_next() % (a ? 3 : 2)];
+        }
+    }
+
+    void releaseAll() {
+        if (_held) _held->setPressed(false);
+        _held = nullptr;
+    }
+
+private:
+    uint32_t    _rng;
+    HostButton* _held        = nullptr;
+    uint32_t    _releaseAt   = 0;
+    uint32_t    _nextPressAt = 0;
+
+    uint32_t _next() { _rng ^= _rng << 13; _rng ^= _rng >> 17; _rng ^= _rng << 5; return _rng; }
+};
+
+// ── Stats ──────────────────────────────────────────────────────────────────
+
+struct BenchPhase {
+    std::vector<uint32_t> ns;
+
+    uint32_t pct(double p) {
+        if (ns.empty()) return 0;
+        std::sort(ns.begin(), ns.end());
+        size_t i = (size_t)(p * (ns.size() - 1) + 0.5);
+        return ns[i];
+    }
+};
+
+struct BenchResult {
+    const char* scene;
+    long        frames;
+    BenchPhase  update, draw, push;
+    uint64_t    allocs;
+    int         exits;      // times the scene left on its own and was re-entered
+    uint64_t    checksum;   // of the final panel image
+};
+
+static uint64_t benchChecksum() {
+    const uint16_t* p = M5.Display.pixels();
+    uint64_t h = 1469598103934665603ull;
+    for (int i = 0; i < M5.Display.width() * M5.Display.height(); i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// ── Runner ─────────────────────────────────────────────────────────────────
+
+static void benchFrame(BenchScript& script, BenchResult* r) {
+    typedef std::chrono::steady_clock Clock;
+    uint32_t dtMs = script.nextDtMs();
+    delay(dtMs);
+    script.apply(millis());
+    float dt = dtMs / 1000.0f;
+
+    uint64_t a0 = gBenchAllocs;
+    auto t0 = Clock::now();
+    M5.update();
+    gInput.update();
+    gSceneManager->update(dt);
+    gContext.tickStats(dt);
+    auto t1 = Clock::now();
+    gSceneManager->draw();
+    auto t2 = Clock::now();
+    gRenderer.show();
+    gRenderer.waitForPush();
+    auto t3 = Clock::now();
+    tickAutoSave(dt);
+
+    if (!r) return;
+    r->frames++;
+    r->allocs += gBenchAllocs - a0;
+    r->update.ns.push_back((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    r->draw.ns.push_back((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count());
+    r->push.ns.push_back((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t3 - t2).count());
+}
+
+static int runBench(const char* const* scenes, int sceneCount, float minutes, uint32_t seed) {
+    const long frames = (long)(minutes * 60.0f * FPS);
+    const int  settle = (int)(3 * TRANSITION_DURATION * FPS) + 2;
+
+    printf("bench: %.1f simulated min/scene (%ld frames), seed %u\n", minutes, frames, seed);
+    printf("%-10s %7s | %-17s | %-17s | %-17s | %7s %5s  %s\n", "scene", "frames",
+           "update p50/p99 us", "draw p50/p99 us", "push p50/p99 us", "allocs", "exits", "checksum");
+
+    for (int s = 0; s < sceneCount; s++) {
+        randomSeed(seed + s);
+        BenchScript script(seed + s);
+        BenchResult r = {};
+        r.scene = scenes[s];
+
+        // Enter the scene; allocations from the switch aren't counted
+        gSceneManager->requestScene(scenes[s]);
+        for (int i = 0; i < settle; i++) benchFrame(script, nullptr);
+        SceneID expected = gSceneManager->currentScene();
+
+        for (long f = 0; f < frames; f++) {
+            benchFrame(script, &r);
+            if (gSceneManager->currentScene() != expected) {
+                r.exits++;
+                script.releaseAll();
+                gSceneManager->requestScene(scenes[s]);
+                for (int i = 0; i < settle; i++) benchFrame(script, nullptr);
+            }
+        }
+        script.releaseAll();
+        r.checksum = benchChecksum();
+
+        printf("%-10s %7ld | %8.1f %8.1f | %8.1f %8.1f | %8.1f %8.1f | %7llu %5d  %016llx\n",
+               r.scene, r.frames,
+               r.update.pct(0.50) / 1000.0, r.update.pct(0.99) / 1000.0,
+               r.draw.pct(0.50)   / 1000.0, r.draw.pct(0.99)   / 1000.0,
+               r.push.pct(0.50)   / 1000.0, r.push.pct(0.99)   / 1000.0,
+               (unsigned long long)r.allocs, r.exits, (unsigned long long)r.checksum);
+    }
+    return 0;
+}
+
+// ── Render pipeline ────────────────────────────────────────────────────────
+
+// Run simTask and rasterTask (started by setup() with gUsePipeline set) on
+// their threads until the raster side has taken frames lists, stop them,
+// and check the ring saw every list once, in order and untouched, and that
+// the panel ends up showing the last frame replayed
+static int runPipelineCheck(long frames) {
+    typedef std::chrono::steady_clock Clock;
+    auto t0 = Clock::now();
+    bool timedOut = false;
+    while ((long)gDrawLists->consumed() < frames) {
+        if (Clock::now() - t0 > std::chrono::seconds(120)) { timedOut = true; break; }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    pipelineRunning() = false;
+    while (pipelineTasks() > 0) std::this_thread::yield();
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+    gRenderer.waitForPush();
+
+    const DrawListRingStats& st = gDrawLists->stats();
+    bool shown = memcmp(M5.Display.pixels(), gRenderer.backBuffer(), DISPLAY_WIDTH * DISPLAY_HEIGHT * 2) == 0;
+    printf("pipeline: %u lists produced, %u consumed in %.2f s, %d slots\n",
+           gDrawLists->produced(), gDrawLists->consumed(), secs, PIPELINE_SLOTS);
+    printf("out of order %u, consumed twice %u, torn %u; panel %s the last frame\n",
+           st.outOfOrder, st.reread, st.torn, shown ? "shows" : "does NOT show");
+    bool ok = !timedOut && st.outOfOrder == 0 && st.reread == 0 && st.torn == 0 && shown;
+    if (timedOut) printf("timed out waiting for %ld frames\n", frames);
+    return ok ? 0 : 1;
+}
+
+// Expected contents of stress list seq: 1-48 commands tagged with seq, and
+// its number as text
+static int benchRingCommands(uint32_t seq) { return 1 + (int)(seq * 2654435761u >> 26) % 48; }
+
+static void benchRingFill(DrawList& l, uint32_t seq) {
+    for (int j = 0, n = benchRingCommands(seq); j < n; j++) {
+        DrawCmd* c = l.add(DrawOp::Rect);
+        c->v[0] = (int16_t)j;
+        c->arg  = (int32_t)seq;
+    }
+    char text[16];
+    snprintf(text, sizeof(text), "%u", (unsigned)seq);
+    l.addText(text);
+}
+
+static bool benchRingMatches(const DrawList& l, uint32_t seq) {
+    int n = benchRingCommands(seq);
+    if (l.count() != n + 1 || l.cmd(n).op != DrawOp::Text) return false;
+    for (int j = 0; j < n; j++)
+        if (l.cmd(j).op != DrawOp::Rect || l.cmd(j).v[0] != j || l.cmd(j).arg != (int32_t)seq) return false;
+    char text[16];
+    snprintf(text, sizeof(text), "%u", (unsigned)seq);
+    return strcmp(l.text(l.cmd(n)), text) == 0;
+}
+
+// One producer and one consumer thread passing lists through an N-slot
+// ring as fast as they can; the consumer checks each list is the next one
+// with exactly what was written into it
+template <int N>
+static bool benchRingStress(long lists) {
+    typedef std::chrono::steady_clock Clock;
+    DrawListRing<N>* ring = new DrawListRing<N>();
+    long wrong = 0, fullSpins = 0, emptySpins = 0;
+    auto t0 = Clock::now();
+    std::thread producer([&]() {
+        for (uint32_t seq = 0; seq < (uint32_t)lists; seq++) {
+            DrawList* l;
+            while (!(l = ring->beginWrite())) { fullSpins++; std::this_thread::yield(); }
+            benchRingFill(*l, seq);
+            ring->publish();
+        }
+    });
+    for (uint32_t seq = 0; seq < (uint32_t)lists; seq++) {
+        const DrawList* l;
+        while (!(l = ring->beginRead())) { emptySpins++; std::this_thread::yield(); }
+        if (!benchRingMatches(*l, seq)) wrong++;
+        ring->release();
+    }
+    producer.join();
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    const DrawListRingStats& st = ring->stats();
+    bool ok = wrong == 0 && st.outOfOrder == 0 && st.reread == 0 && st.torn == 0
+           && ring->produced() == (uint32_t)lists && ring->consumed() == (uint32_t)lists;
+    printf("%5d | %9ld %9.0f | %9ld %9ld | %6ld %6u %6u %6u | %s\n", N, lists, lists / secs,
+           fullSpins, emptySpins, wrong, st.outOfOrder, st.reread, st.torn, ok ? "ok" : "FAIL");
+    delete ring;
+    return ok;
+}
+
+static int runRingStress(long lists) {
+    printf("draw list ring: %ld lists per size, producer and consumer threads\n", lists);
+    printf("%5s | %9s %9s | %9s %9s | %6s %6s %6s %6s |\n", "slots", "lists", "lists/s",
+           "full", "empty", "wrong", "order", "twice", "torn");
+    bool ok = benchRingStress<1>(lists);
+    ok &= benchRingStress<PIPELINE_SLOTS>(lists);
+    ok &= benchRingStress<4>(lists);
+    return ok ? 0 : 1;
+}
+
+// ── Tile diff ──────────────────────────────────────────────────────────────
+
+// Play every scene with tile diff on, then off, and after each frame compare
+// the panel with the frame drawn, which is what a full push would show
+static int runTileDiffCheck(const char* const* scenes, int sceneCount, long frames, uint32_t seed) {
+    const int  settle = (int)(3 * TRANSITION_DURATION * FPS) + 2;
+    const bool wasOn  = gRenderer.tileDiff();
+    printf("tile diff: %ld frames per scene each way, seed %u\n", frames, seed);
+    printf("%-10s | %9s %9s | %9s %9s\n", "scene", "on diffs", "KB/frame", "off diffs", "KB/frame");
+    long total = 0;
+    for (int s = 0; s < sceneCount; s++) {
+        long   diffs[2] = { 0, 0 };
+        double kb[2]    = { 0, 0 };
+        for (int on = 1; on >= 0; on--) {
+            randomSeed(seed + s);
+            BenchScript script(seed + s);
+            gRenderer.setTileDiff(on);
+            gSceneManager->requestScene(scenes[s]);
+            for (int i = 0; i < settle; i++) benchFrame(script, nullptr);
+            uint64_t pushed0 = M5.Display.bytesPushed;
+            for (long f = 0; f < frames; f++) {
+                benchFrame(script, nullptr);
+                if (memcmp(M5.Display.pixels(), gRenderer.backBuffer(), DISPLAY_WIDTH * DISPLAY_HEIGHT * 2) != 0)
+                    diffs[on]++;
+            }
+            script.releaseAll();
+            kb[on] = (M5.Display.bytesPushed - pushed0) / 1024.0 / frames;
+        }
+        total += diffs[0] + diffs[1];
+        printf("%-10s | %9ld %9.1f | %9ld %9.1f\n", scenes[s], diffs[1], kb[1], diffs[0], kb[0]);
+    }
+    gRenderer.setTileDiff(wasOn);
+    printf("%ld frames where the panel differs from a full push\n", total);
+    return total ? 1 : 0;
+}
+
+// ── 1-bit blitter ──────────────────────────────────────────────────────────
+
+// Renderer::drawBitmap1bit before the span blitter: a canvas pixel (or
+// scale x scale rect) per set source pixel
+static void benchBlitPerPixel(M5Canvas& c, const uint8_t* data, int srcW, int srcH, int x, int y,
+                              uint16_t color, int scale, bool mirror) {
+    int stride = (srcW + 7) / 8;
+    for (int row = 0; row < srcH; row++) {
+        for (int col = 0; col < srcW; col++) {
+            int srcCol = mirror ? (srcW - 1 - col) : col;
+            if (!((data[row * stride + srcCol / 8] >> (7 - srcCol % 8)) & 1)) continue;
+            int dx = x + col * scale, dy = y + row * scale;
+            if (scale == 1) c.drawPixel(dx, dy, color);
+            else            c.fillRect(dx, dy, scale, scale, color);
+        }
+    }
+}
+
+// Every layer of every frame of a character sprite, both ways round, at
+// SPRITE_SCALE; calls fn(data, w, h, mirror) for each
+template <class Fn>
+static void benchEachLayer(const Sprite* s, Fn fn) {
+    for (bool m : { false, true }) {
+        for (int f = 0; f < s->frame_count; f++)      if (s->frames[f])      fn(s->frames[f], s->width, s->height, m);
+        for (int f = 0; f < s->fill_frame_count; f++) if (s->fill_frames[f]) fn(s->fill_frames[f], s->width, s->height, m);
+    }
+}
+
+// blit1bit against the old per-pixel path for every sprite in
+// character_assets.h: checks the two draw identical pixels, then times both
+// in drawn pixels per second
+static int runBlitBench(long reps) {
+    typedef std::chrono::steady_clock Clock;
+    const int scale = SPRITE_SCALE;
+    M5Canvas a, b;
+    a.createSprite(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    b.createSprite(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    BlitTarget t{ (uint16_t*)b.getBuffer(), DISPLAY_WIDTH, DISPLAY_HEIGHT };
+
+    // Each sprite once, labelled by the first pose using it
+    struct Item { const Sprite* s; const PoseEntry* pose; const char* part; };
+    std::vector<Item> items;
+    for (int i = 0; i < POSE_TABLE_SIZE; i++) {
+        const PoseEntry& p = POSE_TABLE[i];
+        const Item parts[] = { { p.body, &p, "body" }, { p.head, &p, "head" },
+                               { p.eyes, &p, "eyes" }, { p.tail, &p, "tail" } };
+        for (const Item& it : parts) {
+            bool seen = false;
+            for (const Item& o : items) seen |= o.s == it.s;
+            if (!seen) items.push_back(it);
+        }
+    }
+
+    printf("1-bit blit: %d character sprites, scale %d, %ld reps\n", (int)items.size(), scale, reps);
+    printf("%-36s %5s %7s | %10s %10s %7s\n", "sprite", "size", "px/rep", "old Mpx/s", "span Mpx/s", "speedup");
+    int mismatches = 0;
+    double oldTotal = 0.0, newTotal = 0.0, pxTotal = 0.0;
+    for (const Item& it : items) {
+        const Sprite* s = it.s;
+        const int x = (DISPLAY_WIDTH - s->width * scale) / 2, y = (DISPLAY_HEIGHT - s->height * scale) / 2;
+
+        long px = 0;
+        benchEachLayer(s, [&](const uint8_t* d, int w, int h, bool m) {
+            a.fillScreen(COLOR_BLACK);
+            b.fillScreen(COLOR_BLACK);
+            benchBlitPerPixel(a, d, w, h, x, y, COLOR_WHITE, scale, m);
+            blit1bit(t, d, w, h, x, y, COLOR_WHITE, COLOR_BLACK, true, scale, m);
+            if (memcmp(a.getBuffer(), b.getBuffer(), DISPLAY_WIDTH * DISPLAY_HEIGHT * 2) != 0) mismatches++;
+            for (int i = 0; i < (w + 7) / 8 * h; i++) px += __builtin_popcount(d[i]);
+        });
+        px *= scale * scale;
+
+        auto t0 = Clock::now();
+        for (long r = 0; r < reps; r++)
+            benchEachLayer(s, [&](const uint8_t* d, int w, int h, bool m) {
+                benchBlitPerPixel(a, d, w, h, x, y, COLOR_WHITE, scale, m);
+            });
+        auto t1 = Clock::now();
+        for (long r = 0; r < reps; r++)
+            benchEachLayer(s, [&](const uint8_t* d, int w, int h, bool m) {
+                blit1bit(t, d, w, h, x, y, COLOR_WHITE, COLOR_BLACK, true, scale, m);
+            });
+        auto t2 = Clock::now();
+
+        double oldS = std::chrono::duration<double>(t1 - t0).count();
+        double newS = std::chrono::duration<double>(t2 - t1).count();
+        double drawn = (double)px * reps;
+        oldTotal += oldS; newTotal += newS; pxTotal += drawn;
+        char label[64], size[16];
+        snprintf(label, sizeof(label), "%s.%s.%s %s", it.pose->position, it.pose->direction,
+                 it.pose->emotion, it.part);
+        snprintf(size, sizeof(size), "%dx%d", s->width, s->height);
+        printf("%-36s %5s %7ld | %10.1f %10.1f %6.1fx\n", label, size, px,
+               drawn / oldS / 1e6, drawn / newS / 1e6, oldS / newS);
+    }
+    printf("%-36s %5s %7s | %10.1f %10.1f %6.1fx\n", "all", "", "",
+           pxTotal / oldTotal / 1e6, pxTotal / newTotal / 1e6, oldTotal / newTotal);
+    printf("%d layer/mirror draws differ from the per-pixel path\n", mismatches);
+    return mismatches ? 1 : 0;
+}
+
+// ── Stat effects ───────────────────────────────────────────────────────────
+
+// Per-frame cost of a behavior's stat effects three ways: the fused
+// StatDynamics tick (current: rates added, then one pass over every stat),
+// addStat by id per effect, and addStat by name per effect (a lookup for the
+// read and another for the write, as the old strcmp-chain addStat did).
+// Decay is zeroed, so by name and by id must agree exactly.  The fused tick
+// carries what each add loses to rounding into the next one, so it is held
+// to a double-precision sum of the same per-tick deltas instead, within a
+// bound that doesn't grow with the run: the carry clamp plus half an ulp.
+static const double BENCH_FUSED_TOLERANCE = 2e-5;
+struct BenchEffects { const char* behavior; const StatEffect* fx; int count; };
+#define BENCH_FX(name, cls) { name, cls::FX, (int)(sizeof(cls::FX) / sizeof(cls::FX[0])) }
+static const BenchEffects BENCH_EFFECTS[] = {
+    BENCH_FX("idle",          IdleBehavior),
+    BENCH_FX("sleeping",      SleepingBehavior),
+    BENCH_FX("napping",       NappingBehavior),
+    BENCH_FX("playing",       PlayingBehavior),
+    BENCH_FX("zoomies",       ZoomiesBehavior),
+    BENCH_FX("vocalizing",    VocalizingBehavior),
+    BENCH_FX("investigating", InvestigatingBehavior),
+    BENCH_FX("observing",     ObservingBehavior),
+    BENCH_FX("stretching",    StretchingBehavior),
+    BENCH_FX("selfgrooming",  SelfGroomingBehavior),
+    BENCH_FX("beinggroomed",  BeingGroomedBehavior),
+};
+#undef BENCH_FX
+
+static int runStatBench(long frames) {
+    typedef std::chrono::steady_clock Clock;
+    const float dt = FRAME_TIME_MS / 1000.0f;
+
+    printf("stat effects: %ld frames per behavior\n", frames);
+    printf("%-14s %3s | %9s %9s %9s\n", "behavior", "fx", "name ns", "id ns", "fused ns");
+
+    for (const BenchEffects& b : BENCH_EFFECTS) {
+        GameContext byName, byId, fused;
+        for (int i = 0; i < STAT_COUNT; i++) fused.dynamics.setDecay((StatId)i, 0.0f);
+
+        auto t0 = Clock::now();
+        for (long f = 0; f < frames; f++)
+            for (int i = 0; i < b.count; i++) {
+                const char* n = statName(b.fx[i].stat);
+                byName.setStat(n, byName.getStat(n) + b.fx[i].rate * dt);
+            }
+        auto t1 = Clock::now();
+        for (long f = 0; f < frames; f++)
+            for (int i = 0; i < b.count; i++)
+                byId.addStat(b.fx[i].stat, b.fx[i].rate * dt);
+        auto t2 = Clock::now();
+        for (long f = 0; f < frames; f++) {
+            fused.dynamics.addRates(b.fx, b.count);
+            fused.tickStats(dt);
+        }
+        auto t3 = Clock::now();
+
+        // The fused tick's per-stat delta, summed in double
+        GameContext start;
+        float  rate[STAT_LANES] = {};
+        double ref[STAT_LANES];
+        for (int i = 0; i < b.count; i++) rate[(int)b.fx[i].stat] += b.fx[i].rate;
+        for (int i = 0; i < STAT_LANES; i++) ref[i] = start.stats[i];
+        for (long f = 0; f < frames; f++)
+            for (int i = 0; i < STAT_LANES; i++) ref[i] = std::min(100.0, std::max(0.0, ref[i] + rate[i] * dt));
+        double drift = 0.0;
+        for (int i = 0; i < STAT_LANES; i++) drift = std::max(drift, fabs(fused.stats[i] - ref[i]));
+
+        if (memcmp(byName.stats, byId.stats, sizeof(byId.stats)) != 0 || drift > BENCH_FUSED_TOLERANCE) {
+            fprintf(stderr, "%s: stat update paths disagree\n", b.behavior);
+            return 1;
+        }
+        printf("%-14s %3d | %9.1f %9.1f %9.1f\n", b.behavior, b.count,
+               std::chrono::duration<double, std::nano>(t1 - t0).count() / frames,
+               std::chrono::duration<double, std::nano>(t2 - t1).count() / frames,
+               std::chrono::duration<double, std::nano>(t3 - t2).count() / frames);
+    }
+    return 0;
+}
+
+// ── Behavior selection ─────────────────────────────────────────────────────
+
+// Per-term utility, as a scheduler without the weight matrix would score
+static float benchTermScore(const UtilitySpec& u, const float* stats) {
+    float s = u.base;
+    for (int t = 0; t < u.termCount; t++) {
+        float x = stats[(int)u.term[t].stat] * 0.01f;
+        s += u.term[t].weight * (u.term[t].curve == UtilityCurve::Need ? (1.0f - x) * (1.0f - x) : x * x);
+    }
+    return s;
+}
+
+// Time scoring per term and through the matrix, and a whole pick(), over
+// random stat vectors; the two scores must agree
+template <int N>
+static bool benchSelectRun(const char* label, const BehaviorEntry* entries, long picks, uint32_t& rng) {
+    typedef std::chrono::steady_clock Clock;
+    auto next = [&rng]() { rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5; return rng; };
+    static const int VECTORS = 64;
+    alignas(16) static float stats[VECTORS][STAT_LANES];
+    for (int v = 0; v < VECTORS; v++)
+        for (int i = 0; i < STAT_LANES; i++) stats[v][i] = i < STAT_COUNT ? next() % 10001 / 100.0f : 0.0f;
+
+    UtilityScheduler<N>* sched = new UtilityScheduler<N>(entries);
+    alignas(16) float byTerm[N], byMatrix[UtilityScheduler<N>::LANES];
+    float maxDiff = 0.0f, sink = 0.0f;
+
+    auto t0 = Clock::now();
+    for (long k = 0; k < picks; k++) {
+        const float* st = stats[k % VECTORS];
+        for (int b = 0; b < N; b++) byTerm[b] = benchTermScore(entries[b].utility, st);
+        sink += byTerm[k % N];
+    }
+    auto t1 = Clock::now();
+    for (long k = 0; k < picks; k++) {
+        sched->score(stats[k % VECTORS], byMatrix);
+        sink += byMatrix[k % N];
+    }
+    auto t2 = Clock::now();
+    uint32_t now = 0;
+    for (long k = 0; k < picks; k++) sink += sched->pick(stats[k % VECTORS], now += 15000);
+    auto t3 = Clock::now();
+
+    for (int v = 0; v < VECTORS; v++) {
+        sched->score(stats[v], byMatrix);
+        for (int b = 0; b < N; b++) {
+            float d = fabsf(byMatrix[b] - benchTermScore(entries[b].utility, stats[v]));
+            if (d > maxDiff) maxDiff = d;
+        }
+    }
+    delete sched;
+
+    auto ns = [picks](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::nano>(b - a).count() / picks;
+    };
+    printf("%-10s %9d | %10.0f %10.0f %10.0f | %9.2g%s\n", label, N,
+           ns(t0, t1), ns(t1, t2), ns(t2, t3), maxDiff, sink == 12345.0f ? " " : "");
+    return maxDiff < 1e-4f;
+}
+
+// Synthetic registry: random triggers and 1-3 random utility terms each
+static void benchSyntheticBehaviors(BehaviorEntry* out, int n, uint32_t& rng) {
+    auto next = [&rng]() { rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5; return rng; };
+    for (int b = 0; b < n; b++) {
+        BehaviorEntry& e = out[b];
+        memset(&e, 0, sizeof(e));
+        e.trigger.condCount = next() % 3;
+        for (int c = 0; c < e.trigger.condCount; c++)
+            e.trigger.cond[c] = { (StatId)(next() % STAT_COUNT), 20.0f + next() % 61, next() % 2 == 0 };
+        e.utility.base      = next() % 1000 / 1000.0f;
+        e.utility.cooldownS = (float)(next() % 4) * 30.0f;
+        e.utility.termCount = 1 + next() % 3;
+        for (int t = 0; t < e.utility.termCount; t++)
+            e.utility.term[t] = { (StatId)(next() % STAT_COUNT),
+                                  next() % 2 ? UtilityCurve::Need : UtilityCurve::Surplus,
+                                  0.1f + next() % 190 / 100.0f };
+    }
+}
+
+// One untriggered behavior with a 30 s cooldown, clock starting around where
+// millis() crosses 2^31 and wraps: it's pickable at once, out for 30 s after
+// each pick, then back
+static bool benchCooldownWraps() {
+    BehaviorEntry e;
+    memset(&e, 0, sizeof(e));
+    e.utility.cooldownS = 30.0f;
+    static const uint32_t starts[] = { 0, 0x7FFFF000u, 0x90000000u, 0xFFFFF000u };
+    bool ok = true;
+    for (uint32_t t0 : starts) {
+        UtilityScheduler<1> sched(&e);
+        alignas(16) float stats[STAT_LANES] = {};
+        ok &= sched.pick(stats, t0) == 0 && sched.pick(stats, t0 + 29999) == -1
+           && sched.pick(stats, t0 + 30000) == 0 && sched.pick(stats, t0 + 30001) == -1;
+    }
+    printf("cooldown across millis() wrap: %s\n", ok ? "ok" : "FAIL");
+    return ok;
+}
+
+static int runSelectBench(long picks, uint32_t seed) {
+    uint32_t rng = seed * 2654435761u + 5;
+    static BehaviorEntry synthetic[256];
+    benchSyntheticBehaviors(synthetic, 256, rng);
+
+    printf("behavior selection: %ld picks per set, ns per pick\n", picks);
+    printf("%-10s %9s | %10s %10s %10s | %9s\n", "set", "behaviors",
+           "per-term", "matrix", "pick()", "max diff");
+    bool ok = benchSelectRun<BEHAVIOR_COUNT>("registry", BEHAVIOR_REGISTRY, picks, rng);
+    ok &= benchSelectRun<32>("synthetic", synthetic, picks, rng);
+    ok &= benchSelectRun<128>("synthetic", synthetic, picks, rng);
+    ok &= benchSelectRun<256>("synthetic", synthetic, picks, rng);
+    ok &= benchCooldownWraps();
+    return ok ? 0 : 1;
+}
+
+// ── Phase timelines ────────────────────────────────────────────────────────
+
+// Run B on a character of its own at the game's frame rate and check it
+// walks its PHASES table: each phase change goes to the table's next phase
+// with that phase's pose, and it completes within a frame per phase of
+// phaseTableSeconds(PHASES)
+template <class B>
+static bool checkPhases(const char* label) {
+    typedef typename B::Phase P;
+    const float dt     = 1.0f / FPS;
+    const int   phases = (int)P::Done;
+    const float want   = phaseTableSeconds(B::PHASES);
+
+    GameContext     ctx;
+    CharacterEntity ch(0, 0, "sitting.forward.neutral", &ctx);
+    B* b = ch.makeBehavior<B>();
+    ch.trigger(b);
+    bool ok      = b->phase() == 0;
+    int  changes = 0;
+    long f       = 0;
+    for (; f < lroundf((want + phases) * FPS) && ch.currentBehavior() == b; f++) {
+        uint8_t before = b->phase();
+        ch.update(dt);
+        if (ch.currentBehavior() != b || b->phase() == before) continue;
+        const PhaseStep<P>& s = B::PHASES[b->phase()];
+        ok &= (uint8_t)B::PHASES[before].next == b->phase();
+        ok &= s.pose == PoseId::None || s.pose == ch.pose();
+        changes++;
+    }
+    float took = f * dt;
+    ok &= ch.currentBehavior() != b && changes == phases - 1;
+    ok &= took >= want && took <= want + phases * dt + 1e-3f;
+    printf("%-14s %6d | %8.2f %8.2f | %s\n", label, phases, want, took, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+static int runPhaseCheck() {
+    printf("phase timelines at %d fps\n", FPS);
+    printf("%-14s %6s | %8s %8s |\n", "behavior", "phases", "table s", "ran s");
+    bool ok = true;
+    ok &= checkPhases<SleepingBehavior>("sleeping");
+    ok &= checkPhases<NappingBehavior>("napping");
+    ok &= checkPhases<PlayingBehavior>("playing");
+    ok &= checkPhases<ZoomiesBehavior>("zoomies");
+    ok &= checkPhases<VocalizingBehavior>("vocalizing");
+    ok &= checkPhases<InvestigatingBehavior>("investigating");
+    ok &= checkPhases<ObservingBehavior>("observing");
+    ok &= checkPhases<SelfGroomingBehavior>("self_grooming");
+    ok &= checkPhases<StretchingBehavior>("stretching");
+    ok &= checkPhases<LoungeingBehavior>("lounging");
+    ok &= checkPhases<KneadingBehavior>("kneading");
+    ok &= checkPhases<BeingGroomedBehavior>("being_groomed");
+    ok &= checkPhases<ChatteringBehavior>("chattering");
+    return ok ? 0 : 1;
+}
+
+// ── Environment store ──────────────────────────────────────────────────────
+
+// The Environment object store as it was before the layer buckets: objects
+// in add order, never reused, every one visited for every layer
+struct BenchEnvReference {
+    struct Obj { EnvObject o; Layer layer; };
+    std::vector<Obj> objs;
+    float            cameraX = 0.0f;
+
+    void draw(Renderer& r) const {
+        for (int layer = 0; layer < LAYER_COUNT; layer++) {
+            float camOff = cameraX * PARALLAX[layer];
+            for (const Obj& e : objs) {
+                const EnvObject& o = e.o;
+                if (!o.active || e.layer != layer || !o.sprite) continue;
+                int sx = (int)(o.x - camOff);
+                int sy = (int)(o.y) + PLAY_Y;
+                if (sx + o.sprite->width * SPRITE_SCALE < 0 || sx > DISPLAY_WIDTH) continue;
+                r.drawSpriteObj(o.sprite, sx, sy, o.frame, o.mirror_h);
+            }
+        }
+    }
+};
+
+// Random adds, removes, moves, frame changes and camera moves on an
+// Environment and the reference, recording both draws each frame: the
+// draw lists must match command for command
+static int runEnvCheck(long frames, uint32_t seed) {
+    uint32_t rng = seed * 2654435761u + 7;
+    auto next = [&rng]() { rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5; return rng; };
+    static const float WIDTHS[] = { 512.0f, 4096.0f, 16384.0f };
+    static const int   WORLD_FRAMES = 60;
+
+    Renderer  r;
+    DrawList* got  = new DrawList();
+    DrawList* want = new DrawList();
+    long worlds = 0, draws = 0, mismatches = 0, dropped = 0;
+
+    for (long f = 0; f < frames; worlds++) {
+        float               width = WIDTHS[next() % 3];
+        Environment*        env   = new Environment(width);
+        BenchEnvReference   ref;
+        std::vector<std::pair<EnvObject*, int>> live;   // object, reference index
+
+        for (int k = 0; k < WORLD_FRAMES && f < frames; k++, f++) {
+            for (int ops = 1 + next() % 4; ops > 0; ops--) {
+                float x = (float)(next() % (uint32_t)(width + 128)) - 64.0f + (next() % 100) / 100.0f;
+                float y = (float)(next() % PLAY_HEIGHT);
+                switch (next() % 6) {
+                case 0: case 1: {
+                    const PoseEntry& p = POSE_TABLE[next() % POSE_TABLE_SIZE];
+                    const Sprite* sp = next() % 16 == 0 ? nullptr : next() % 2 ? p.body : p.head;
+                    Layer layer = (Layer)(next() % LAYER_COUNT);
+                    bool  mirror = next() % 2;
+                    if (EnvObject* o = env->addObject(layer, sp, x, y, mirror)) {
+                        ref.objs.push_back({ *o, layer });
+                        live.push_back({ o, (int)ref.objs.size() - 1 });
+                    }
+                    break;
+                }
+                case 2:
+                    if (!live.empty()) {
+                        size_t i = next() % live.size();
+                        env->removeObject(live[i].first);
+                        ref.objs[live[i].second].o.active = false;
+                        live.erase(live.begin() + i);
+                    }
+                    break;
+                case 3:
+                    if (!live.empty()) {
+                        auto& e = live[next() % live.size()];
+                        env->moveObject(e.first, x, y);
+                        ref.objs[e.second].o.x = x;
+                        ref.objs[e.second].o.y = y;
+                    }
+                    break;
+                case 4:
+                    if (!live.empty()) {
+                        auto& e = live[next() % live.size()];
+                        e.first->frame = ref.objs[e.second].o.frame = next() % 3;
+                    }
+                    break;
+                default:
+                    if (next() % 2) env->setCamera(x);
+                    else            env->pan((float)(next() % 81) - 40.0f);
+                    break;
+                }
+            }
+            ref.cameraX = env->cameraX;
+
+            got->reset();
+            want->reset();
+            r.recordInto(got);
+            env->draw(r);
+            r.recordInto(want);
+            ref.draw(r);
+            r.recordInto(nullptr);
+            draws += want->count();
+            dropped += got->dropped() + want->dropped();
+            if (got->count() != want->count() || got->checksum() != want->checksum()) mismatches++;
+        }
+        delete env;
+    }
+    delete got;
+    delete want;
+
+    printf("environment store: %ld worlds, %ld frames, %ld sprite draws, %ld mismatched frames\n",
+           worlds, frames, draws, mismatches);
+    bool ok = mismatches == 0 && dropped == 0;
+    printf("%s\n", ok ? "pass: same sprites drawn in the same order" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// ── Sky ────────────────────────────────────────────────────────────────────
+
+// Panel checksum of one sky frame, cached or direct
+static uint64_t benchSkyFrame(SkyCache* cache, const SkyKey& k, float anim) {
+    gRenderer.clear(COLOR_BLACK);
+    if (cache) cache->draw(gRenderer, k, anim);
+    else       SkyCache::drawDirect(gRenderer, k, anim);
+    gRenderer.show();
+    gRenderer.waitForPush();
+    return benchChecksum();
+}
+
+// Check the cached sky against drawing it directly for every hour, weather
+// and moon phase, then time both for a few looks, the night sky with stars
+// first
+static int runSkyBench(long frames) {
+    typedef std::chrono::steady_clock Clock;
+    SkyCache cache;
+    int mismatches = 0;
+    for (int h = 0; h < 24; h++)
+        for (int w = 0; w < 5; w++)
+            for (int m = 0; m < 8; m++)
+                for (float anim : { 0.0f, 0.4f, 1.1f, 7.3f })
+                    if (benchSkyFrame(&cache, { h, w, m }, anim) != benchSkyFrame(nullptr, { h, w, m }, anim))
+                        mismatches++;
+
+    static const struct { const char* label; SkyKey key; } LOOKS[] = {
+        { "night stars", { 23, 0, 2 } },
+        { "night full",  { 23, 0, 4 } },
+        { "noon",        { 12, 0, 4 } },
+        { "dawn",        {  6, 0, 4 } },
+        { "rain",        { 15, 2, 4 } },
+        { "snow",        {  2, 4, 4 } },
+    };
+    printf("sky draw: %ld frames per look, %d cached/direct mismatches\n", frames, mismatches);
+    printf("%-12s | %9s %9s\n", "look", "direct us", "cached us");
+    const float dt = FRAME_TIME_MS / 1000.0f;
+    for (const auto& l : LOOKS) {
+        auto t0 = Clock::now();
+        for (long f = 0; f < frames; f++) SkyCache::drawDirect(gRenderer, l.key, f * dt);
+        auto t1 = Clock::now();
+        for (long f = 0; f < frames; f++) cache.draw(gRenderer, l.key, f * dt);
+        auto t2 = Clock::now();
+        printf("%-12s | %9.2f %9.2f\n", l.label,
+               std::chrono::duration<double, std::micro>(t1 - t0).count() / frames,
+               std::chrono::duration<double, std::micro>(t2 - t1).count() / frames);
+    }
+    gRenderer.clear(COLOR_BLACK);
+    return mismatches ? 1 : 0;
+}
+
+// ── Particles ──────────────────────────────────────────────────────────────
+
+// Fill the pool to a few sizes with every kind mixed, then time a frame's
+// update() and draw(); fails if a full pool doesn't fit in a frame
+static int runParticleBench(long frames) {
+    typedef std::chrono::steady_clock Clock;
+    const float dt = FRAME_TIME_MS / 1000.0f;
+    printf("particles: %ld frames per size, frame time %d ms\n", frames, FRAME_TIME_MS);
+    printf("%6s | %9s %9s %9s | %6s\n", "live", "update us", "draw us", "total us", "frame%");
+    bool ok = true;
+    for (int n : { 128, 256, PARTICLE_MAX }) {
+        ParticleSystem ps;
+        for (int k = 0; ps.count() < n; k++) {
+            EmitterSpec s = { (ParticleKind)(k % (int)ParticleKind::Count), 1.0f / dt,
+                              0, DISPLAY_WIDTH, PLAY_Y, DISPLAY_HEIGHT - 6,
+                              0.0f, 0.0f, 0.5f, 0.5f, 1e9f, 0.0f };
+            float carry = 0.0f;
+            ps.emit(s, dt, carry);
+            if (k % PARTICLE_FRAME_BUDGET == PARTICLE_FRAME_BUDGET - 1) ps.update(0.0f);
+        }
+        double upUs = 0.0, drawUs = 0.0;
+        for (long f = 0; f < frames; f++) {
+            auto t0 = Clock::now();
+            ps.update(dt);
+            auto t1 = Clock::now();
+            ps.draw(gRenderer);
+            auto t2 = Clock::now();
+            upUs   += std::chrono::duration<double, std::micro>(t1 - t0).count();
+            drawUs += std::chrono::duration<double, std::micro>(t2 - t1).count();
+        }
+        upUs /= frames;
+        drawUs /= frames;
+        double pct = (upUs + drawUs) / (FRAME_TIME_MS * 10.0);
+        ok &= ps.count() == n && pct < 100.0;
+        printf("%6d | %9.2f %9.2f %9.2f | %5.2f%%\n", ps.count(), upUs, drawUs, upUs + drawUs, pct);
+    }
+    gRenderer.clear(COLOR_BLACK);
+    return ok ? 0 : 1;
+}
+
+// ── Offline catch-up ───────────────────────────────────────────────────────
+
+// Reference for catchUpOffline: a character left alone from idle, stepped
+// at the game's frame rate with the real behaviors and a fresh scheduler,
+// the virtual clock moving with it so cooldowns run
+static void offlineReference(GameContext& ctx, float seconds) {
+    const float dt     = 1.0f / FPS;
+    const long  frames = lroundf(seconds * FPS);
+    behaviorScheduler().reset();
+    CharacterEntity ch(0, 0, "sitting.forward.neutral", &ctx);
+    ch.trigger(ch.makeIdleBehavior());
+    for (long f = 0; f < frames; f++) {
+        ch.update(dt);
+        ctx.tickStats(dt);
+        host::advanceUs(1000000 / FPS);
+    }
+}
+
+// Compare catchUpOffline against offlineReference from a few starting
+// states.  Both draw random() (tie-band picks, the stretch-to-kneading
+// chain, poses), so single runs can differ by whole behaviors; each start
+// is run OFFLINE_CHECK_RUNS times with different seeds and the mean final
+// stats compared.  Fails if any stat's means differ by more than tolerance
+// plus three standard errors of that difference; the stat closest to
+// failing is printed.  A short run goes first: the one-off chains (sleeping
+// from a low start into a stretch) are lost in the spread of a long one.
+static const int   OFFLINE_CHECK_RUNS  = 16;
+static const float OFFLINE_CHECK_SHORT = 0.05f;   // hours
+
+static int offlineCheckSpan(float hours, float tolerance) {
+    typedef std::chrono::steady_clock Clock;
+    static const float STARTS[][2] = {   // energy, fullness
+        { 60.0f, 50.0f }, { 29.0f, 90.0f }, { 100.0f, 10.0f }, { 44.9f, 0.0f },
+    };
+    const float seconds = hours * 3600.0f;
+    const int   n       = OFFLINE_CHECK_RUNS;
+    int failures = 0;
+
+    printf("offline catch-up: %.2f h, %d runs each, tolerance %.2f + 3 SE\n",
+           hours, n, tolerance);
+    printf("%-8s %-8s | %10s %10s | %8s %8s %-12s\n",
+           "energy", "fullness", "closed us", "frames ms", "diff", "bound", "stat");
+    for (const auto& s : STARTS) {
+        double sum[2][STAT_COUNT] = {}, sq[2][STAT_COUNT] = {};   // closed, frames
+        double closedUs = 0.0, framesMs = 0.0;
+        for (int run = 0; run < n; run++) {
+            GameContext closed;
+            closed.setStat(StatId::Energy, s[0]);
+            closed.setStat(StatId::Fullness, s[1]);
+            GameContext frames = closed;
+
+            randomSeed(run + 1);
+            auto t0 = Clock::now();
+            catchUpOffline(closed, seconds);
+            auto t1 = Clock::now();
+            offlineReference(frames, seconds);
+            auto t2 = Clock::now();
+            closedUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+            framesMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+
+            for (int i = 0; i < STAT_COUNT; i++) {
+                sum[0][i] += closed.stats[i]; sq[0][i] += (double)closed.stats[i] * closed.stats[i];
+                sum[1][i] += frames.stats[i]; sq[1][i] += (double)frames.stats[i] * frames.stats[i];
+            }
+        }
+
+        double diff = -1.0, bound = 0.0;
+        int    id   = 0;
+        for (int i = 0; i < STAT_COUNT; i++) {
+            double var = 0.0;
+            for (int k = 0; k < 2; k++) {
+                double mean = sum[k][i] / n;
+                var += max(0.0, sq[k][i] / n - mean * mean) / (n - 1);
+            }
+            double d = fabs(sum[0][i] - sum[1][i]) / n;
+            double b = tolerance + 3.0 * sqrt(var);
+            if (diff >= 0.0 && d * bound <= diff * b) continue;
+            diff = d; bound = b; id = i;
+        }
+        if (diff > bound) failures++;
+        printf("%8.1f %8.1f | %10.1f %10.1f | %8.3f %8.3f %-12s%s\n", s[0], s[1],
+               closedUs / n, framesMs / n, diff, bound, STAT_NAMES[id],
+               diff > bound ? "  FAIL" : "");
+    }
+    return failures;
+}
+
+static int runOfflineCheck(float hours, float tolerance) {
+    int failures = offlineCheckSpan(OFFLINE_CHECK_SHORT, tolerance);
+    failures += offlineCheckSpan(hours, tolerance);
+    return failures ? 1 : 0;
+}
+
+// ── Persistence ────────────────────────────────────────────────────────────
+
+// NVS traffic of Persistence over simulated play in the normal scene, with
+// bursts of environment edits like a player stepping through Settings.  The
+// old scheme (8 putFloat every 60 s, 4 putInt on every Settings press) is
+// tallied alongside for comparison.
+static int runPersistBench(float minutes, uint32_t seed) {
+    const long frames = (long)(minutes * 60.0f * FPS);
+    const int  settle = (int)(3 * TRANSITION_DURATION * FPS) + 2;
+    BenchScript script(seed);
+    uint32_t rng = seed * 2654435761u + 7;
+    auto next = [&rng]() { rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5; return rng; };
+
+    gSceneManager->requestScene("normal");
+    for (int i = 0; i < settle; i++) benchFrame(script, nullptr);
+
+    NvsCounters  nvs0  = Preferences::counters();
+    PersistStats p0    = gPersist.stats();
+    uint32_t     start = millis();
+    uint32_t     nextBurst = start + 30000 + next() % 60000, nextPress = 0;
+    int          presses = 0, bursts = 0, pressesLeft = 0;
+
+    for (long f = 0; f < frames; f++) {
+        uint32_t now = millis();
+        if (!pressesLeft && now >= nextBurst) { pressesLeft = 3 + next() % 6; nextPress = now; bursts++; }
+        if (pressesLeft && now >= nextPress) {
+            EnvironmentCtx& e = gContext.environment;
+            e.time_of_day = (e.time_of_day + 1) % 24;
+            presses++;
+            nextPress = now + 300 + next() % 500;
+            if (--pressesLeft == 0) nextBurst = now + 30000 + next() % 60000;
+        }
+        benchFrame(script, nullptr);
+    }
+    script.releaseAll();
+
+    double   hours    = (millis() - start) / 3600000.0;
+    uint64_t oldSaves = (millis() - start) / 60000;
+    uint64_t oldPuts  = oldSaves * 8 + presses * 4;
+    NvsCounters nvs = Preferences::counters();
+    nvs.puts -= nvs0.puts; nvs.bytes -= nvs0.bytes; nvs.entries -= nvs0.entries;
+
+    printf("persistence: %.1f simulated min, %d settings presses in %d bursts\n",
+           minutes, presses, bursts);
+    printf("%-10s %8s %10s %10s %12s\n", "scheme", "puts", "bytes", "entries", "entries/h");
+    printf("%-10s %8llu %10llu %10llu %12.0f\n", "old",
+           (unsigned long long)oldPuts, (unsigned long long)(oldPuts * 4),
+           (unsigned long long)oldPuts, oldPuts / hours);
+    printf("%-10s %8llu %10llu %10llu %12.0f\n", "journal",
+           (unsigned long long)nvs.puts, (unsigned long long)nvs.bytes,
+           (unsigned long long)nvs.entries, nvs.entries / hours);
+    printf("saves %u: %u snapshots, %u journal records (lifetime snapshots %u)\n",
+           gPersist.stats().writes - p0.writes, gPersist.stats().snapshots - p0.snapshots,
+           gPersist.stats().records - p0.records, gPersist.stats().lifetime);
+    return 0;
+}
+
+// ── Journal fuzzing ────────────────────────────────────────────────────────
+
+// True if b holds a's saved state (stats to the journal's 0.01 resolution)
+static bool benchSameSave(const GameContext& a, const GameContext& b) {
+    for (int i = 0; i < STAT_COUNT; i++)
+        if (fabsf(a.stats[i] - b.stats[i]) > 0.011f) return false;
+    const EnvironmentCtx &ea = a.environment, &eb = b.environment;
+    return ea.time_of_day == eb.time_of_day && ea.season == eb.season
+        && ea.moon_phase == eb.moon_phase && ea.weather == eb.weather
+        && a.highScoreMaze == b.highScoreMaze && a.highScoreBreakout == b.highScoreBreakout
+        && a.inventory.snacks[0] == b.inventory.snacks[0];
+}
+
+// Random saves with power cut at a random byte of some of the writes.  After
+// each cut the device "reboots": a fresh Persistence must load either the
+// state of the last completed save or the one being written.
+static int runJournalFuzz(long iterations, uint32_t seed) {
+    uint32_t rng = seed * 2654435761u + 11;
+    auto next = [&rng]() { rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5; return rng; };
+
+    Preferences::store().clear();
+    GameContext  ctx;
+    Persistence* persist = new Persistence(&ctx);
+    persist->load();
+    GameContext committed = ctx;
+    long tears = 0, reboots = 0, olderState = 0, failures = 0;
+
+    for (long it = 0; it < iterations; it++) {
+        for (int n = 1 + next() % 4; n > 0; n--)
+            ctx.addStat((StatId)(next() % STAT_COUNT), (int)(next() % 1001 - 500) / 100.0f);
+        if (next() % 8 == 0) ctx.environment.weather = next() % 5;
+        if (next() % 16 == 0) ctx.highScoreMaze++;
+        if (next() % 16 == 0) ctx.inventory.snacks[0] = SNACK_CATALOG[next() % SNACK_CATALOG_COUNT];
+
+        bool tear = next() % 3 == 0;
+        if (tear) Preferences::tearNextWrite(next() % 180);
+        uint32_t writes = persist->stats().writes;
+        persist->flush();
+        bool wrote = persist->stats().writes != writes;
+        Preferences::tearNextWrite(-1);
+
+        if (!tear && next() % 8 != 0) {
+            if (wrote) committed = ctx;
+            continue;
+        }
+
+        // Reboot from flash
+        GameContext attempted = ctx;
+        delete persist;
+        ctx     = GameContext();
+        persist = new Persistence(&ctx);
+        persist->load();
+        bool asCommitted = benchSameSave(committed, ctx);
+        bool asAttempted = benchSameSave(attempted, ctx);
+        if (tear) tears++;
+        else      reboots++;
+        if (!asCommitted && !asAttempted) {
+            failures++;
+            if (failures <= 5) fprintf(stderr, "save %ld: reloaded state matches neither save\n", it);
+        } else if (!asAttempted) {
+            olderState++;
+        }
+        committed = ctx;
+    }
+    delete persist;
+
+    printf("journal fuzz: %ld saves, %ld cut by power loss, %ld clean reboots\n",
+           iterations, tears, reboots);
+    printf("recovered: %ld to the save being written, %ld to the one before; %ld failures\n",
+           tears + reboots - olderState - failures, olderState, failures);
+    return failures ? 1 : 0;
+}
+
+// ── Heap soak ──────────────────────────────────────────────────────────────
+
+// Hours of scripted play, switching between the normal and outside scenes
+// every simulated hour, with the heap watched for behavior churn.  The first
+// WARMUP hours build both scenes and are warm-up; after them, any heap
+// allocation, growth in live heap bytes or behavior pool overflow fails.
+// With no hours after warm-up there is nothing to check, so that's an error.
+static int runSoak(float hours, uint32_t seed) {
+    static const char* const SCENES[] = { "normal", "outside" };
+    static const int WARMUP = 2;
+    const long perHour = 3600L * FPS;
+    const int  settle  = (int)(3 * TRANSITION_DURATION * FPS) + 2;
+
+    if ((int)hours <= WARMUP) {
+        fprintf(stderr, "soak: HOURS must be more than the %d warm-up hours\n", WARMUP);
+        return 2;
+    }
+    BenchScript script(seed);
+    printf("soak: %.0f simulated h, seed %u\n", hours, seed);
+    printf("%4s %-8s %9s %9s %11s %9s %6s %9s\n", "hour", "scene", "behaviors",
+           "allocs", "live bytes", "pool use", "peak", "overflows");
+
+    int64_t  baseLive   = 0;
+    uint64_t lateAllocs = 0;
+    bool     grew       = false;
+    for (int h = 0; h < (int)hours; h++) {
+        const char* scene = SCENES[h % 2];
+        gSceneManager->requestScene(scene);
+        for (int i = 0; i < settle; i++) benchFrame(script, nullptr);
+        SceneID expected = gSceneManager->currentScene();
+
+        if (h == WARMUP) baseLive = gBenchLiveBytes;
+        uint64_t a0 = gBenchAllocs;
+        uint32_t b0 = behaviorPool().stats().acquired;
+        for (long f = 0; f < perHour; f++) {
+            benchFrame(script, nullptr);
+            if (gSceneManager->currentScene() != expected) {
+                script.releaseAll();
+                gSceneManager->requestScene(scene);
+            }
+        }
+        script.releaseAll();
+
+        uint64_t allocs = gBenchAllocs - a0;
+        const BehaviorPoolStats& ps = behaviorPool().stats();
+        if (h >= WARMUP) {
+            lateAllocs += allocs;
+            if (gBenchLiveBytes > baseLive) grew = true;
+        }
+        printf("%4d %-8s %9u %9llu %11lld %9u %6u %9u\n", h + 1, scene,
+               ps.acquired - b0, (unsigned long long)allocs, (long long)gBenchLiveBytes,
+               ps.inUse, ps.peak, ps.overflows);
+    }
+
+    bool ok = lateAllocs == 0 && !grew && behaviorPool().stats().overflows == 0;
+    printf("%s: %llu heap allocations after warm-up, live heap %s\n", ok ? "pass" : "FAIL",
+           (unsigned long long)lateAllocs, grew ? "grew" : "flat");
+    return ok ? 0 : 1;
+}
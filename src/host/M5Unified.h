@@ -0,0 +1,267 @@
+#pragma once
+// M5Unified.h - Headless host backend for the M5Unified / M5GFX API we use
+//
+// Native build only.  M5.Display and M5Canvas rasterize into in-memory RGB565
+// buffers using the same byte-swapped layout as LovyanGFX sprites, so the
+// Renderer fast paths (blitter, sprite cache, frame diff) run unchanged.
+// M5.Display keeps the image the panel would show; pushImageDMA transfers are
+// applied when waitDMA()/endWrite() is reached, like the real DMA completing.
+// Buttons are driven by the host harness with setPressed().  M5.Rtc reads a
+// settable start time plus the virtual clock.
+
+#include <Arduino.h>
+#include <vector>
+#include "glcdfont.h"
+
+namespace lgfx { struct swap565_t { uint16_t raw; }; }
+
+// ── Rasterizer shared by the panel and canvases ────────────────────────────
+
+class HostGFX {
+public:
+    virtual ~HostGFX() {}
+
+    int   width()  const { return _w; }
+    int   height() const { return _h; }
+    void* getBuffer()    { return _buf.empty() ? nullptr : _buf.data(); }
+    const uint16_t* pixels() const { return _buf.data(); }
+
+    void setClipRect(int x, int y, int w, int h) {
+        _cx0 = max(0, x);      _cy0 = max(0, y);
+        _cx1 = min(_w, x + w); _cy1 = min(_h, y + h);
+    }
+    void clearClipRect() { _cx0 = 0; _cy0 = 0; _cx1 = _w; _cy1 = _h; }
+
+    void fillScreen(uint16_t c) { fillRect(0, 0, _w, _h, c); }
+
+    void drawPixel(int x, int y, uint16_t c) {
+        if (x >= _cx0 && x < _cx1 && y >= _cy0 && y < _cy1) _buf[y * _w + x] = _swap(c);
+    }
+
+    void fillRect(int x, int y, int w, int h, uint16_t c) {
+        int x0 = max(x, _cx0), y0 = max(y, _cy0);
+        int x1 = min(x + w, _cx1), y1 = min(y + h, _cy1);
+        uint16_t s = _swap(c);
+        for (int yy = y0; yy < y1; yy++)
+            std::fill(&_buf[yy * _w + x0], &_buf[yy * _w + x0] + max(0, x1 - x0), s);
+    }
+
+    void drawRect(int x, int y, int w, int h, uint16_t c) {
+        if (w <= 0 || h <= 0) return;
+        fillRect(x, y, w, 1, c);         fillRect(x, y + h - 1, w, 1, c);
+        fillRect(x, y, 1, h, c);         fillRect(x + w - 1, y, 1, h, c);
+    }
+
+    void drawLine(int x0, int y0, int x1, int y1, uint16_t c) {
+        int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+        int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+        int err = dx + dy;
+        for (;;) {
+            drawPixel(x0, y0, c);
+            if (x0 == x1 && y0 == y1) break;
+            int e2 = 2 * err;
+            if (e2 >= dy) { err += dy; x0 += sx; }
+            if (e2 <= dx) { err += dx; y0 += sy; }
+        }
+    }
+
+    void drawCircle(int cx, int cy, int r, uint16_t c) {
+        int x = r, y = 0, err = 1 - r;
+        while (x >= y) {
+            drawPixel(cx + x, cy + y, c); drawPixel(cx - x, cy + y, c);
+            drawPixel(cx + x, cy - y, c); drawPixel(cx - x, cy - y, c);
+            drawPixel(cx + y, cy + x, c); drawPixel(cx - y, cy + x, c);
+            drawPixel(cx + y, cy - x, c); drawPixel(cx - y, cy - x, c);
+            y++;
+            if (err < 0) err += 2 * y + 1;
+            else         { x--; err += 2 * (y - x) + 1; }
+        }
+    }
+
+    void fillCircle(int cx, int cy, int r, uint16_t c) {
+        for (int dy = -r; dy <= r; dy++) {
+            int dx = (int)sqrtf((float)(r * r - dy * dy));
+            fillRect(cx - dx, cy + dy, 2 * dx + 1, 1, c);
+        }
+    }
+
+    void drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2, uint16_t c) {
+        drawLine(x0, y0, x1, y1, c); drawLine(x1, y1, x2, y2, c); drawLine(x2, y2, x0, y0, c);
+    }
+
+    void fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, uint16_t c) {
+        const int px[3] = { x0, x1, x2 }, py[3] = { y0, y1, y2 };
+        int top = min(y0, min(y1, y2)), bottom = max(y0, max(y1, y2));
+        for (int y = top; y <= bottom; y++) {
+            int a = 0x7FFF, b = -0x7FFF;
+            for (int i = 0; i < 3; i++) {
+                int j = (i + 1) % 3;
+                if (py[i] == py[j]) {
+                    if (py[i] == y) { a = min(a, min(px[i], px[j])); b = max(b, max(px[i], px[j])); }
+                    continue;
+                }
+                if (y < min(py[i], py[j]) || y > max(py[i], py[j])) continue;
+                int x = px[i] + (y - py[i]) * (px[j] - px[i]) / (py[j] - py[i]);
+                a = min(a, x); b = max(b, x);
+            }
+            if (a <= b) fillRect(a, y, b - a + 1, 1, c);
+        }
+    }
+
+    // ── Text: 6x8 cells, background painted unless it equals the foreground
+    void setTextColor(uint16_t fg)              { _fg = fg; _bg = fg; }
+    void setTextColor(uint16_t fg, uint16_t bg) { _fg = fg; _bg = bg; }
+    void setTextSize(int s)                     { _ts = max(1, s); }
+    void setCursor(int x, int y)                { _tx = x; _ty = y; _tx0 = x; }
+
+    size_t print(const char* s) {
+        size_t n = 0;
+        for (; *s; s++, n++) {
+            if (*s == '\n') { _tx = _tx0; _ty += 8 * _ts; continue; }
+            _glyph((uint8_t)*s);
+            _tx += 6 * _ts;
+        }
+        return n;
+    }
+
+protected:
+    std::vector<uint16_t> _buf;   // byte-swapped RGB565, row-major
+    int      _w = 0, _h = 0;
+    int      _cx0 = 0, _cy0 = 0, _cx1 = 0, _cy1 = 0;
+    uint16_t _fg = 0xFFFF, _bg = 0;
+    int      _ts = 1, _tx = 0, _ty = 0, _tx0 = 0;
+
+    static uint16_t _swap(uint16_t c) { return (uint16_t)((c >> 8) | (c << 8)); }
+
+    void _alloc(int w, int h) {
+        _w = w; _h = h;
+        _buf.assign((size_t)w * h, 0);
+        clearClipRect();
+    }
+
+    void _glyph(uint8_t ch) {
+        if (_bg != _fg) fillRect(_tx, _ty, 6 * _ts, 8 * _ts, _bg);
+        if (ch < HOST_FONT_FIRST || ch > HOST_FONT_LAST) return;
+        const uint8_t* cols = HOST_FONT[ch - HOST_FONT_FIRST];
+        for (int cx = 0; cx < 5; cx++)
+            for (int cy = 0; cy < 8; cy++)
+                if (cols[cx] & (1 << cy)) fillRect(_tx + cx * _ts, _ty + cy * _ts, _ts, _ts, _fg);
+    }
+};
+
+// ── Panel ──────────────────────────────────────────────────────────────────
+
+class M5GFX : public HostGFX {
+public:
+    // Landscape like the M5StickC Plus2 at rotation 1/3
+    void setRotation(int) { if (!_w) _alloc(240, 135); }
+    void setBrightness(int) {}
+
+    void startWrite() {}
+    void endWrite()   { waitDMA(); }
+    void initDMA()    {}
+    bool dmaBusy() const { return !_pending.empty(); }
+
+    template <typename T>
+    void pushImageDMA(int x, int y, int w, int h, const T* data) {
+        _pending.push_back({ x, y, w, h, (const uint16_t*)data });
+    }
+    void waitDMA() {
+        for (const Transfer& t : _pending) _blit(t.x, t.y, t.w, t.h, t.data, t.w);
+        _pending.clear();
+    }
+
+    // Copy a byte-swapped RGB565 block, honoring the clip rect
+    void _blit(int x, int y, int w, int h, const uint16_t* src, int stride) {
+        for (int r = 0; r < h; r++) {
+            int dy = y + r;
+            if (dy < _cy0 || dy >= _cy1) continue;
+            int c0 = max(0, _cx0 - x), c1 = min(w, _cx1 - x);
+            if (c0 >= c1) continue;
+            memcpy(&_buf[dy * _w + x + c0], src + r * stride + c0, (size_t)(c1 - c0) * 2);
+            bytesPushed += (uint64_t)(c1 - c0) * 2;
+        }
+    }
+
+    uint64_t bytesPushed = 0;   // everything sent to the "panel" so far
+
+private:
+    struct Transfer { int x, y, w, h; const uint16_t* data; };
+    std::vector<Transfer> _pending;
+};
+
+// ── Off-screen canvas ──────────────────────────────────────────────────────
+
+class M5Canvas : public HostGFX {
+public:
+    explicit M5Canvas(M5GFX* parent = nullptr) : _parent(parent) {}
+
+    void  setPsram(bool) {}
+    void  setColorDepth(int) {}
+    void* createSprite(int w, int h) { _alloc(w, h); return getBuffer(); }
+    void  deleteSprite() { _buf.clear(); _w = _h = 0; }
+    void  pushSprite(int x, int y) { if (_parent) _parent->_blit(x, y, _w, _h, _buf.data(), _w); }
+
+private:
+    M5GFX* _parent;
+};
+
+// ── Buttons / M5 ───────────────────────────────────────────────────────────
+
+class HostButton {
+public:
+    void setPressed(bool down) { _down = down; }
+    bool isPressed() const     { return _down; }
+private:
+    bool _down = false;
+};
+
+// ── RTC ────────────────────────────────────────────────────────────────────
+
+namespace m5 {
+    struct rtc_date_t { int16_t year; int8_t month, date, weekDay; };
+    struct rtc_time_t { int8_t hours, minutes, seconds; };
+    struct rtc_datetime_t { rtc_date_t date; rtc_time_t time; };
+}
+
+class HostRtc {
+public:
+    bool isEnabled() const { return true; }
+
+    // Unix time the virtual clock's zero corresponds to
+    void setEpoch(uint32_t sec) { _epoch = sec; }
+
+    m5::rtc_datetime_t getDateTime() const {
+        uint32_t t = _epoch + millis() / 1000;
+        int32_t  z = (int32_t)(t / 86400) + 719468;       // civil-from-days
+        int32_t  era = z / 146097, doe = z - era * 146097;
+        int32_t  yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        int32_t  doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        int32_t  mp = (5 * doy + 2) / 153, m = mp < 10 ? mp + 3 : mp - 9;
+        m5::rtc_datetime_t dt;
+        dt.date.year    = (int16_t)(yoe + era * 400 + (m <= 2));
+        dt.date.month   = (int8_t)m;
+        dt.date.date    = (int8_t)(doy - (153 * mp + 2) / 5 + 1);
+        dt.date.weekDay = (int8_t)((t / 86400 + 4) % 7);
+        dt.time.hours   = (int8_t)(t / 3600 % 24);
+        dt.time.minutes = (int8_t)(t / 60 % 60);
+        dt.time.seconds = (int8_t)(t % 60);
+        return dt;
+    }
+
+private:
+    uint32_t _epoch = 1767225600;   // 2026-01-01 00:00:00
+};
+
+struct HostM5 {
+    struct config_t {};
+
+    M5GFX      Display;
+    HostButton BtnA, BtnB, BtnPWR;
+    HostRtc    Rtc;
+
+    config_t config() const { return config_t(); }
+    void     begin(const config_t&) {}
+    void     update() {}
+};
+static HostM5 M5;
@@ -0,0 +1,98 @@
+#pragma once
+// Preferences.h - Host stand-in for the ESP32 NVS Preferences API
+//
+// Keys live in a process-wide map, namespaced like NVS, and are lost on exit.
+// counters() tallies writes the way NVS spends flash: one 32-byte entry per
+// integer or float, and for a blob one per 32 bytes plus a header and index.
+// tearNextWrite(n) makes the next blob write stop after n bytes, leaving the
+// rest of the old value in place, like power failing mid-write.  A blob key
+// reserves NVS_BLOB_MAX bytes on its first write, so rewriting it with a
+// value of another length doesn't show up as heap traffic in --soak.
+
+#include <stdint.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+static const size_t NVS_BLOB_MAX = 4000;   // largest blob in one NVS page
+
+struct NvsCounters {
+    uint64_t puts = 0, bytes = 0, entries = 0;
+};
+
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false) { _ns = name; _ro = readOnly; return true; }
+    void end() {}
+
+    size_t  putInt(const char* key, int32_t v)        { return _put(key, &v, sizeof(v), 1); }
+    size_t  putUInt(const char* key, uint32_t v)      { return _put(key, &v, sizeof(v), 1); }
+    size_t  putFloat(const char* key, float v)        { return _put(key, &v, sizeof(v), 1); }
+    size_t  putBool(const char* key, bool v)          { uint8_t b = v; return _put(key, &b, 1, 1); }
+    int32_t getInt(const char* key, int32_t def = 0)  { int32_t v = def;  getBytes(key, &v, sizeof(v)); return v; }
+    uint32_t getUInt(const char* key, uint32_t def = 0) { uint32_t v = def; getBytes(key, &v, sizeof(v)); return v; }
+    float   getFloat(const char* key, float def = 0)  { float v = def;    getBytes(key, &v, sizeof(v)); return v; }
+    bool    getBool(const char* key, bool def = false) { uint8_t b = def; getBytes(key, &b, 1); return b != 0; }
+
+    size_t putBytes(const char* key, const void* v, size_t n) {
+        if (!_ro) store()[_ns + "/" + key].reserve(NVS_BLOB_MAX);
+        if (tearAt() >= 0 && !_ro) {
+            std::vector<uint8_t>& cur = store()[_ns + "/" + key];
+            cur.resize(n);
+            memcpy(cur.data(), v, (size_t)tearAt() < n ? (size_t)tearAt() : n);
+            tearAt() = -1;
+            return 0;
+        }
+        return _put(key, v, n, (n + 31) / 32 + 2);
+    }
+    size_t getBytesLength(const char* key) {
+        auto it = store().find(_ns + "/" + key);
+        return it == store().end() ? 0 : it->second.size();
+    }
+    size_t getBytes(const char* key, void* buf, size_t maxLen) {
+        auto it = store().find(_ns + "/" + key);
+        if (it == store().end() || it->second.size() > maxLen) return 0;
+        memcpy(buf, it->second.data(), it->second.size());
+        return it->second.size();
+    }
+
+    bool isKey(const char* key)  { return store().count(_ns + "/" + key) != 0; }
+    bool remove(const char* key) { return !_ro && store().erase(_ns + "/" + key) != 0; }
+    bool clear() {
+        if (_ro) return false;
+        std::string prefix = _ns + "/";
+        for (auto it = store().begin(); it != store().end();)
+            it = it->first.compare(0, prefix.size(), prefix) == 0 ? store().erase(it) : ++it;
+        return true;
+    }
+
+    static std::map<std::string, std::vector<uint8_t>>& store() {
+        static std::map<std::string, std::vector<uint8_t>> s;
+        return s;
+    }
+
+    static void tearNextWrite(long n) { tearAt() = n; }
+    static long& tearAt() {
+        static long n = -1;
+        return n;
+    }
+
+    static NvsCounters& counters() {
+        static NvsCounters c;
+        return c;
+    }
+
+private:
+    std::string _ns;
+    bool        _ro = false;
+
+    size_t _put(const char* key, const void* v, size_t n, size_t entries) {
+        if (_ro) return 0;
+        store()[_ns + "/" + key].assign((const uint8_t*)v, (const uint8_t*)v + n);
+        counters().puts++;
+        counters().bytes   += n;
+        counters().entries += entries;
+        return n;
+    }
+};
@@ -0,0 +1,213 @@
+// host_main.cpp - Headless native runner for the firmware (pio run -e native)
+//
+// Builds main.cpp against the host stand-ins in this directory and drives
+// setup()/loop() with no hardware: time is virtual, so frames run as fast as
+// the host can render them.  Frames can be dumped as PPM images.
+//
+//   program [--frames N] [--scene NAME|all] [--seed S] [--press-rate P]
+//           [--dump DIR] [--dump-every K]
+//   program --bench MINUTES [--seed S]
+//   program --check-pipeline FRAMES [--seed S]
+//   program --stress-ring LISTS
+//   program --check-tilediff FRAMES [--seed S]
+//   program --bench-blit REPS
+//   program --bench-stats FRAMES
+//   program --bench-select PICKS [--seed S]
+//   program --check-offline HOURS
+//   program --check-phases
+//   program --check-env FRAMES [--seed S]
+//   program --bench-sky FRAMES
+//   program --bench-particles FRAMES
+//   program --bench-persist MINUTES [--seed S]
+//   program --fuzz-journal SAVES [--seed S]
+//   program --soak HOURS [--seed S]
+//
+// --scene all cycles through every scene, N/8 frames each.  --press-rate
+// gives the per-frame chance (0..1) of toggling a random button.  --bench
+// runs the scripted-input benchmark in Bench.h over every scene;
+// --check-pipeline runs the sim and raster tasks on threads and checks the
+// draw-list handoff; --stress-ring hammers the ring from two threads;
+// --check-tilediff checks tile-diff pushes against full pushes;
+// --bench-blit compares the span blitter with the old per-pixel path;
+// --bench-stats times every behavior's per-frame stat effects;
+// --bench-select times behavior selection with up to 256 behaviors;
+// --check-offline compares offline catch-up with a real character run
+// frame by frame; --check-phases runs each phased behavior through its
+// PHASES table;
+// --check-env compares the Environment object store with the old one;
+// --bench-sky checks and times the cached outdoor sky; --bench-particles
+// times the particle pool at 128 to 512 live particles;
+// --bench-persist counts NVS writes over simulated play; --fuzz-journal
+// cuts power during random saves and checks what reloads; --soak plays for
+// hours and fails on steady-state heap traffic.
+
+#include "../main.cpp"
+#include "Bench.h"
+
+#include <chrono>
+#include <string>
+
+static const char* const HOST_SCENES[] = {
+    "normal", "outside", "stats", "zoomies", "maze", "breakout", "tictactoe", "snake"
+};
+static const int HOST_SCENE_COUNT = sizeof(HOST_SCENES) / sizeof(HOST_SCENES[0]);
+
+// Write what the panel currently shows as a binary PPM
+static bool writePPM(const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    int w = M5.Display.width(), h = M5.Display.height();
+    fprintf(f, "P6\n%d %d\n255\n", w, h);
+    const uint16_t* px = M5.Display.pixels();
+    std::vector<uint8_t> row((size_t)w * 3);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            uint16_t c = px[y * w + x];
+            c = (uint16_t)((c >> 8) | (c << 8));   // panel layout is byte-swapped
+            uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+            row[x * 3 + 0] = (uint8_t)((r << 3) | (r >> 2));
+            row[x * 3 + 1] = (uint8_t)((g << 2) | (g >> 4));
+            row[x * 3 + 2] = (uint8_t)((b << 3) | (b >> 2));
+        }
+        fwrite(row.data(), 1, row.size(), f);
+    }
+    fclose(f);
+    return true;
+}
+
+static void usage(const char* prog) {
+    fprintf(stderr,
+            "usage: %s [--frames N] [--scene NAME|all] [--seed S] [--press-rate P]\n"
+            "          [--dump DIR] [--dump-every K]\n"
+            "       %s --bench MINUTES [--seed S]\n"
+            "       %s --check-pipeline FRAMES [--seed S]\n"
+            "       %s --stress-ring LISTS\n"
+            "       %s --check-tilediff FRAMES [--seed S]\n"
+            "       %s --bench-blit REPS\n"
+            "       %s --bench-stats FRAMES\n"
+            "       %s --bench-select PICKS [--seed S]\n"
+            "       %s --check-offline HOURS\n"
+            "       %s --check-phases\n"
+            "       %s --check-env FRAMES [--seed S]\n"
+            "       %s --bench-sky FRAMES\n"
+            "       %s --bench-particles FRAMES\n"
+            "       %s --bench-persist MINUTES [--seed S]\n"
+            "       %s --fuzz-journal SAVES [--seed S]\n"
+            "       %s --soak HOURS [--seed S]\n", prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog);
+}
+
+int main(int argc, char** argv) {
+    long        frames    = 1000;
+    std::string scene     = "";
+    uint32_t    seed      = 1;
+    float       pressRate = 0.0f;
+    std::string dumpDir   = "";
+    long        dumpEvery = 1;
+    float       benchMin  = 0.0f;
+    long        pipelineFrames = 0;
+    long        ringLists  = 0;
+    long        tileFrames = 0;
+    long        blitReps  = 0;
+    long        statFrames = 0;
+    long        selectPicks = 0;
+    float       offlineHours = 0.0f;
+    bool        checkPhases = false;
+    long        envFrames  = 0;
+    long        skyFrames  = 0;
+    long        particleFrames = 0;
+    float       persistMin = 0.0f;
+    long        fuzzSaves  = 0;
+    float       soakHours  = 0.0f;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if      (a == "--frames"     && v) { frames    = atol(v); i++; }
+        else if (a == "--scene"      && v) { scene     = v;       i++; }
+        else if (a == "--seed"       && v) { seed      = (uint32_t)strtoul(v, nullptr, 10); i++; }
+        else if (a == "--press-rate" && v) { pressRate = (float)atof(v); i++; }
+        else if (a == "--dump"       && v) { dumpDir   = v;       i++; }
+        else if (a == "--dump-every" && v) { dumpEvery = max(1L, atol(v)); i++; }
+        else if (a == "--bench"      && v) { benchMin  = (float)atof(v); i++; }
+        else if (a == "--check-pipeline" && v) { pipelineFrames = atol(v); i++; }
+        else if (a == "--stress-ring" && v)   { ringLists = atol(v); i++; }
+        else if (a == "--check-tilediff" && v) { tileFrames = atol(v); i++; }
+        else if (a == "--bench-blit" && v)  { blitReps = atol(v); i++; }
+        else if (a == "--bench-stats" && v) { statFrames = atol(v); i++; }
+        else if (a == "--bench-select" && v) { selectPicks = atol(v); i++; }
+        else if (a == "--check-offline" && v) { offlineHours = (float)atof(v); i++; }
+        else if (a == "--check-phases")       { checkPhases = true; }
+        else if (a == "--check-env" && v)     { envFrames = atol(v); i++; }
+        else if (a == "--bench-sky" && v)     { skyFrames = atol(v); i++; }
+        else if (a == "--bench-particles" && v) { particleFrames = atol(v); i++; }
+        else if (a == "--bench-persist" && v) { persistMin = (float)atof(v); i++; }
+        else if (a == "--fuzz-journal" && v) { fuzzSaves = atol(v); i++; }
+        else if (a == "--soak" && v)          { soakHours = (float)atof(v); i++; }
+        else { usage(argv[0]); return 2; }
+    }
+
+    if (ringLists > 0)      return runRingStress(ringLists);
+    if (blitReps > 0)       return runBlitBench(blitReps);
+    if (statFrames > 0)     return runStatBench(statFrames);
+    if (selectPicks > 0)    return runSelectBench(selectPicks, seed);
+    if (offlineHours > 0.0f) return runOfflineCheck(offlineHours, 0.5f);
+    if (checkPhases)        return runPhaseCheck();
+    if (envFrames > 0)      return runEnvCheck(envFrames, seed);
+    if (fuzzSaves > 0)      return runJournalFuzz(fuzzSaves, seed);
+
+    // With the pipeline on, setup() starts the sim and raster threads and
+    // they run the frames
+    if (pipelineFrames > 0) gUsePipeline = true;
+    randomSeed(seed);
+    setup();
+    if (gUsePipeline) return runPipelineCheck(pipelineFrames > 0 ? pipelineFrames : frames);
+
+    if (benchMin > 0.0f)   return runBench(HOST_SCENES, HOST_SCENE_COUNT, benchMin, seed);
+    if (tileFrames > 0)    return runTileDiffCheck(HOST_SCENES, HOST_SCENE_COUNT, tileFrames, seed);
+    if (skyFrames > 0)     return runSkyBench(skyFrames);
+    if (particleFrames > 0) return runParticleBench(particleFrames);
+    if (persistMin > 0.0f) return runPersistBench(persistMin, seed);
+    if (soakHours > 0.0f)  return runSoak(soakHours, seed);
+
+    bool cycle = scene == "all";
+    if (!cycle && !scene.empty() && !gSceneManager->requestScene(scene.c_str())) {
+        fprintf(stderr, "unknown scene '%s'\n", scene.c_str());
+        return 2;
+    }
+    long perScene = max(1L, frames / HOST_SCENE_COUNT);
+
+    // Button toggles use their own generator so they don't shift the game's
+    uint32_t inputRng = seed * 2654435761u + 1;
+    HostButton* buttons[] = { &M5.BtnA, &M5.BtnB, &M5.BtnPWR };
+    bool        down[3]   = { false, false, false };
+
+    auto start = std::chrono::steady_clock::now();
+    for (long f = 0; f < frames; f++) {
+        if (cycle && f % perScene == 0)
+            gSceneManager->requestScene(HOST_SCENES[(f / perScene) % HOST_SCENE_COUNT]);
+
+        if (pressRate > 0.0f) {
+            inputRng ^= inputRng << 13; inputRng ^= inputRng >> 17; inputRng ^= inputRng << 5;
+            if ((inputRng % 10000) < (uint32_t)(pressRate * 10000)) {
+                int b = (inputRng >> 16) % 3;
+                down[b] = !down[b];
+                buttons[b]->setPressed(down[b]);
+            }
+        }
+
+        loop();
+
+        if (!dumpDir.empty() && f % dumpEvery == 0) {
+            gRenderer.waitForPush();
+            char path[512];
+            snprintf(path, sizeof(path), "%s/frame_%06ld.ppm", dumpDir.c_str(), f);
+            if (!writePPM(path)) { fprintf(stderr, "can't write %s\n", path); return 1; }
+        }
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    fprintf(stderr, "%ld frames in %.3f s (%.0f fps), %.1f KB pushed per frame\n",
+            frames, secs, frames / secs,
+            M5.Display.bytesPushed / 1024.0 / max(1L, frames));
+    return 0;
+}
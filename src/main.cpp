@@ -5,12 +5,16 @@
 #include "Input.h"
 #include "GameContext.h"
 #include "SceneManager.h"
+#include "FramePipeline.h"
+#include "OfflineProgress.h"
+#include "Persistence.h"
 #include "assets/boot_img_assets.h"
 
 // ── Global singletons ──────────────────────────────────────────────────────────
 static Renderer     gRenderer;
 static InputHandler gInput;
 static GameContext  gContext;
+static Persistence  gPersist(&gContext);
 static SceneManager* gSceneManager = nullptr;
 
 // ── Boot screen ────────────────────────────────────────────────────────────────
@@ -32,6 +36,100 @@ static void showBootScreen() {
     delay(1400);
 }
 
+// ── Frame timing ───────────────────────────────────────────────────────────────
+static void logFrameTiming(uint32_t updateUs, uint32_t drawUs, const PushStats& push) {
+    static uint32_t sumUpdate = 0, sumDraw = 0, sumPush = 0, sumWait = 0, sumBytes = 0;
+    static uint32_t frames = 0, windowStart = 0;
+    sumUpdate += updateUs;
+    sumDraw   += drawUs;
+    sumPush   += push.pushUs;
+    sumWait   += push.waitUs;
+    sumBytes  += push.bytes;
+    frames++;
+
+    uint32_t now = millis();
+    if (now - windowStart < 1000) return;
+    Serial.printf("frame us: update %lu draw %lu push %lu wait %lu | %lu B/frame, %lu fps%s\n",
+                  (unsigned long)(sumUpdate / frames), (unsigned long)(sumDraw / frames),
+                  (unsigned long)(sumPush / frames),   (unsigned long)(sumWait / frames),
+                  (unsigned long)(sumBytes / frames),  (unsigned long)frames,
+                  gRenderer.asyncPush() ? "" : " (sync)");
+    sumUpdate = sumDraw = sumPush = sumWait = sumBytes = frames = 0;
+    windowStart = now;
+}
+
+// ── Frame helpers (shared by loop() and the pipeline sim task) ────────────────
+static float frameDelta(uint32_t now) {
+    static uint32_t lastMs = 0;
+    float dt = (now - lastMs) / 1000.0f;
+    if (dt > 0.1f) dt = 0.1f;
+    lastMs = now;
+    return dt;
+}
+
+// Save whatever changed, once Persistence's debounce allows
+static void tickAutoSave(float dt) {
+    gPersist.update(dt);
+}
+
+static void waitFrame(uint32_t startMs) {
+    uint32_t elapsed = millis() - startMs;
+    if (elapsed < (uint32_t)FRAME_TIME_MS) delay(FRAME_TIME_MS - elapsed);
+}
+
+// ── Render pipeline (USE_RENDER_PIPELINE) ──────────────────────────────────────
+// Scenes draw into gRecorder, which only records; the raster task replays the
+// lists into gRenderer. Scene code can't tell the difference.
+static Renderer                      gRecorder;
+static DrawListRing<PIPELINE_SLOTS>* gDrawLists = nullptr;
+static bool                          gUsePipeline = USE_RENDER_PIPELINE;   // host checks set it before setup()
+
+static void simTask(void*) {
+    bool started = false;
+    while (pipelineRunning()) {
+        uint32_t now = millis();
+        float dt = frameDelta(now);
+
+        DrawList* list;
+        while (!(list = gDrawLists->beginWrite()) && pipelineRunning()) pipelineYield();
+        if (!list) break;
+
+        // Record the whole step: scene switches in update() set frame diff
+        gRecorder.recordInto(list);
+        if (!started) { gSceneManager->begin(); started = true; }
+        M5.update();
+        { ProfileScope prof(ProfZone::Input);       gInput.update(); }
+        { ProfileScope prof(ProfZone::SceneUpdate); gSceneManager->update(dt); gContext.tickStats(dt); }
+        { ProfileScope prof(ProfZone::SceneDraw);   gSceneManager->draw(); }
+        gRecorder.recordInto(nullptr);
+        gDrawLists->publish();
+        if (PROFILER_ENABLED) profiler().endFrame();   // sim-side zones only
+
+        tickAutoSave(dt);
+        waitFrame(now);
+    }
+    endPipelineTask();
+}
+
+static void rasterTask(void*) {
+    while (pipelineRunning()) {
+        const DrawList* list = gDrawLists->beginRead();
+        if (!list) { pipelineYield(); continue; }
+        if (list->dropped()) Serial.printf("draw list full: %d commands dropped\n", list->dropped());
+        gRenderer.replay(*list);
+        gDrawLists->release();
+        gRenderer.show();
+    }
+    endPipelineTask();
+}
+
+static void startPipeline() {
+    gRenderer.waitForPush();   // boot screen transfer, started on this task
+    gDrawLists = new DrawListRing<PIPELINE_SLOTS>();
+    startPipelineTask(rasterTask, nullptr, "raster", PIPELINE_RASTER_CORE, 8192);
+    startPipelineTask(simTask,    nullptr, "sim",    PIPELINE_SIM_CORE,    8192);
+}
+
 // ── Arduino setup ──────────────────────────────────────────────────────────────
 void setup() {
     auto cfg = M5.config();
@@ -40,35 +138,39 @@ void setup() {
     // Display orientation: landscape, USB connector on left
     // Display setup and double-buffer canvas are initialized in gRenderer.begin()
     gRenderer.begin();
-    gContext.loadEnv();
-    gContext.loadPetStats();
-    gSceneManager = new SceneManager(&gContext, &gRenderer, &gInput);
+    gPersist.load();
+    catchUpSinceSave(gContext);
+    gSceneManager = new SceneManager(&gContext,
+                                     gUsePipeline ? &gRecorder : &gRenderer,
+                                     &gInput);
 
     showBootScreen();
 
-    gSceneManager->begin();
+    if (gUsePipeline) startPipeline();
+    else                     gSceneManager->begin();
 }
 
 // ── Arduino loop ───────────────────────────────────────────────────────────────
 void loop() {
-    static uint32_t lastMs = 0;
+    if (gUsePipeline) { delay(1000); return; }   // work runs in simTask/rasterTask
+
     uint32_t now = millis();
-    float dt = (now - lastMs) / 1000.0f;
-    if (dt > 0.1f) dt = 0.1f;
-    lastMs = now;
+    float dt = frameDelta(now);
 
     M5.update();
 
-    gInput.update();
-    gSceneManager->update(dt);
-    gSceneManager->draw();
-    gRenderer.show();
-
-    // Periodic pet stat save (every 60 s)
-    static float sSaveTimer = 0.0f;
-    sSaveTimer += dt;
-    if (sSaveTimer >= 60.0f) { sSaveTimer = 0.0f; gContext.savePetStats(); }
+    // update/draw run while the previous frame is still going out by DMA;
+    // show() waits for that transfer before starting this frame's
+    uint32_t t0 = micros();
+    { ProfileScope prof(ProfZone::Input);       gInput.update(); }
+    { ProfileScope prof(ProfZone::SceneUpdate); gSceneManager->update(dt); gContext.tickStats(dt); }
+    uint32_t t1 = micros();
+    { ProfileScope prof(ProfZone::SceneDraw);   gSceneManager->draw(); }
+    uint32_t t2 = micros();
+    { ProfileScope prof(ProfZone::Push);        gRenderer.show(); }
+    if (LOG_FRAME_TIMING) logFrameTiming(t1 - t0, t2 - t1, gRenderer.lastPush());
+    if (PROFILER_ENABLED) profiler().endFrame();
 
-    uint32_t elapsed = millis() - now;
-    if (elapsed < (uint32_t)FRAME_TIME_MS) delay(FRAME_TIME_MS - elapsed);
+    tickAutoSave(dt);
+    waitFrame(now);
 }
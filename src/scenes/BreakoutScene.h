@@ -21,6 +21,7 @@ public:
         : Scene(ctx,r,inp), _state(ST_IDLE) {}
 
     void enter() override { _reset(); }
+    bool diffFrames() const override { return true; }
 
     void draw() override {
         _renderer->clear();
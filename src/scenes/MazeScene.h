@@ -16,6 +16,7 @@ public:
           _wonTimer(0.0f), _moves(0), _score(0) {}
 
     void enter() override { _generate(); _won=false; _moves=0; _wonTimer=0; }
+    bool diffFrames() const override { return true; }
 
     SceneResult update(float dt) override {
         if (_won) {
@@ -71,6 +71,7 @@ public:
             "sitting.forward.neutral",
             _context
         );
+        _character->particles = &particlePool();
 
         // Start idle behavior
         _character->setCurrentBehavior(_character->makeIdleBehavior());
@@ -84,13 +85,15 @@ public:
         delete _env;       _env       = nullptr;
     }
 
-    void enter() override {}
+    void enter() override { particlePool().clear(); }
     void exit() override {}
+    bool diffFrames() const override { return true; }
 
     SceneResult update(float dt) override {
         if (!_character || !_env) return NO_CHANGE;
 
         _character->update(dt);
+        particlePool().update(dt);
 
         // Animate fish rotation (frame cycling)
         _fishAngle += dt * 25.0f;
@@ -101,8 +104,7 @@ public:
             if (_eatingBehavior->active()) {
                 int bx, by;
                 _eatingBehavior->getBowlPosition(_character->x, _character->y, false, bx, by);
-                _foodBowlObj->x     = bx;
-                _foodBowlObj->y     = by;
+                _env->moveObject(_foodBowlObj, bx, by);
                 _foodBowlObj->frame = _eatingBehavior->getBowlFrame();
             } else {
                 // Eating ended — remove bowl
@@ -132,13 +134,14 @@ public:
 
         // Draw character
         int camOff = (int)_env->cameraX;
+        particlePool().draw(*_renderer, camOff);
         _character->draw(*_renderer, false, camOff);
 
         // Status bar
         _renderer->drawStatusBar(
-            _context->fullness  / 100.0f,
-            _context->energy    / 100.0f,
-            _context->affection / 100.0f
+            _context->getStat(StatId::Fullness) / 100.0f,
+            _context->getStat(StatId::Energy) / 100.0f,
+            _context->getStat(StatId::Affection) / 100.0f
         );
     }
 
@@ -222,19 +225,19 @@ private:
         if (!item || !item->actionParam) return;
         const char* p = item->actionParam;
 
-        if (strcmp(p,"pets")==0)  { _character->trigger(new AffectionBehavior(_character)); }
-        else if (strcmp(p,"kiss")==0)  { auto* b=new AffectionBehavior(_character); _character->trigger(b); b->start("kiss"); }
-        else if (strcmp(p,"psst")==0)  { auto* b=new AttentionBehavior(_character); _character->trigger(b); b->start("psst"); }
-        else if (strcmp(p,"groom")==0) { _character->trigger(new BeingGroomedBehavior(_character)); }
+        if (strcmp(p,"pets")==0)  { _character->trigger(_character->makeBehavior<AffectionBehavior>()); }
+        else if (strcmp(p,"kiss")==0)  { auto* b=_character->makeBehavior<AffectionBehavior>(); _character->trigger(b); b->start("kiss"); }
+        else if (strcmp(p,"psst")==0)  { auto* b=_character->makeBehavior<AttentionBehavior>(); _character->trigger(b); b->start("psst"); }
+        else if (strcmp(p,"groom")==0) { _character->trigger(_character->makeBehavior<BeingGroomedBehavior>()); }
         else if (strncmp(p,"meal:",5)==0) { _startEating(p+5); }
-        else if (strcmp(p,"Treat")==0) { auto* b=new SnackingBehavior(_character); _character->trigger(b); b->start("treat"); }
+        else if (strcmp(p,"Treat")==0) { auto* b=_character->makeBehavior<SnackingBehavior>(); _character->trigger(b); b->start("treat"); }
         else { // toy or snack
-            auto* b=new PlayingBehavior(_character); _character->trigger(b); b->start("toy");
+            auto* b=_character->makeBehavior<PlayingBehavior>(); _character->trigger(b); b->start("toy");
         }
     }
 
     void _startEating(const char* mealType) {
-        auto* b = new EatingBehavior(_character);
+        auto* b = _character->makeBehavior<EatingBehavior>();
         b->start(&FOOD_BOWL, mealType, [](bool, float, void* ud){
             NormalScene* self = (NormalScene*)ud;
             if (self->_foodBowlObj) {
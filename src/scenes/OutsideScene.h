@@ -3,6 +3,7 @@
 
 #include "Scene.h"
 #include "Environment.h"
+#include "SkyCache.h"
 #include "Menu.h"
 #include "entities/CharacterEntity.h"
 #include "entities/ButterflyEntity.h"
@@ -67,6 +68,7 @@ public:
             "sitting.forward.neutral",
             _context
         );
+        _character->particles = &particlePool();
         _character->setCurrentBehavior(_character->makeIdleBehavior());
         _character->currentBehavior()->start();
 
@@ -83,12 +85,16 @@ public:
         delete _butterfly2; _butterfly2 = nullptr;
     }
 
-    void enter() override {}
+    void enter() override { particlePool().clear(); }
     void exit() override {}
+    bool diffFrames() const override { return true; }
 
     SceneResult update(float dt) override {
         _timeAnim += dt;
         if (_character) _character->update(dt);
+        const EnvironmentCtx& e = _context->environment;
+        _weatherFx.update(particlePool(), e.weather, e.season, dt);
+        particlePool().update(dt);
         if (_butterfly1) _butterfly1->update(dt);
         if (_butterfly2) _butterfly2->update(dt);
         return NO_CHANGE;
@@ -106,13 +112,14 @@ public:
 
         int camOff = (int)_env->cameraX;
         if (_character) _character->draw(*_renderer, true, camOff);
+        particlePool().drawWorld(*_renderer, camOff);   // dust over the ground
         if (_butterfly1) _butterfly1->draw(*_renderer, camOff);
         if (_butterfly2) _butterfly2->draw(*_renderer, camOff);
 
         _renderer->drawStatusBar(
-            _context->fullness  / 100.0f,
-            _context->energy    / 100.0f,
-            _context->affection / 100.0f
+            _context->getStat(StatId::Fullness) / 100.0f,
+            _context->getStat(StatId::Energy) / 100.0f,
+            _context->getStat(StatId::Affection) / 100.0f
         );
     }
 
@@ -147,6 +154,8 @@ private:
     ButterflyEntity*  _butterfly2;
     bool              _menuActive;
     float             _timeAnim;
+    SkyCache          _sky;
+    WeatherFx         _weatherFx;
 
     MenuItem  _menuItems[OUTSIDE_MENU_MAX];
     MenuItem  _toysSubmenu[OUTSIDE_TOY_MAX];
@@ -172,12 +181,12 @@ private:
     void _handleMenuAction(const MenuItem* item) {
         if (!item || !item->actionParam) return;
         const char* p = item->actionParam;
-        if (strcmp(p,"pets")==0)        { _character->trigger(new AffectionBehavior(_character)); }
-        else if (strcmp(p,"groom")==0)  { _character->trigger(new BeingGroomedBehavior(_character)); }
-        else if (strcmp(p,"point_bird")==0) { auto* b=new AttentionBehavior(_character); _character->trigger(b); b->start("point_bird"); }
-        else if (strcmp(p,"throw_stick")==0){ auto* b=new PlayingBehavior(_character); _character->trigger(b); b->start("throw_stick"); }
-        else if (strcmp(p,"treat")==0)  { auto* b=new SnackingBehavior(_character); _character->trigger(b); b->start("treat"); }
-        else { auto* b=new PlayingBehavior(_character); _character->trigger(b); b->start("toy"); }
+        if (strcmp(p,"pets")==0)        { _character->trigger(_character->makeBehavior<AffectionBehavior>()); }
+        else if (strcmp(p,"groom")==0)  { _character->trigger(_character->makeBehavior<BeingGroomedBehavior>()); }
+        else if (strcmp(p,"point_bird")==0) { auto* b=_character->makeBehavior<AttentionBehavior>(); _character->trigger(b); b->start("point_bird"); }
+        else if (strcmp(p,"throw_stick")==0){ auto* b=_character->makeBehavior<PlayingBehavior>(); _character->trigger(b); b->start("throw_stick"); }
+        else if (strcmp(p,"treat")==0)  { auto* b=_character->makeBehavior<SnackingBehavior>(); _character->trigger(b); b->start("treat"); }
+        else { auto* b=_character->makeBehavior<PlayingBehavior>(); _character->trigger(b); b->start("toy"); }
     }
 
     static void _drawGround(Renderer& r, float camX, float par, void* data) {
@@ -195,90 +204,13 @@ private:
         }
     }
 
+    // Sky, then lightning and weather particles over it, behind the rest
     static void _drawSky(Renderer& r, float camX, float par, void* data) {
         OutsideScene* self = (OutsideScene*)data;
-        int hour    = self ? self->_context->environment.time_of_day : 12;
-        int weather = self ? self->_context->environment.weather     : 0;
-        int moonPh  = self ? self->_context->environment.moon_phase  : 4;
-        float anim  = self ? self->_timeAnim : 0.0f;
-
-        // Classify time of day
-        bool isNight = (hour < 5 || hour >= 21);
-        bool isDawn  = (hour >= 5 && hour <= 7);
-        bool isDusk  = (hour >= 18 && hour < 21);
-
-        // Base sky color
-        uint16_t skyColor;
-        if (isNight)     skyColor = COLOR_SKY_NIGHT;        // deep navy
-        else if (isDawn) skyColor = 0xFD60;                 // warm orange-pink
-        else if (isDusk) skyColor = 0xCA46;                 // purple-orange
-        else             skyColor = COLOR_SKY_DAY;          // bright blue day
-
-        // Overcast tint for cloudy/rain/storm/snow
-        if (weather >= 1) skyColor = 0x6B4D;                // flat gray
-
-        int skyH = PLAY_HEIGHT * 2 / 3;
-        r.drawRect(0, PLAY_Y, DISPLAY_WIDTH, skyH, skyColor, true);
-
-        if (isNight && weather == 0) {
-            // Stars (pseudo-random, twinkle based on anim)
-            uint32_t seed = 0xDEADBEEF;
-            for (int i = 0; i < 14; i++) {
-                seed = seed * 1664525u + 1013904223u;
-                int sx = (int)((seed >> 16) & 0xFFFF) % (DISPLAY_WIDTH - 4) + 2;
-                seed = seed * 1664525u + 1013904223u;
-                int sy = PLAY_Y + 2 + (int)((seed >> 16) & 0xFFFF) % (skyH - 4);
-                if ((int)(anim * 3 + i) % 5 != 0)   // occasional twinkle off
-                    r.drawPixel(sx, sy, COLOR_WHITE);
-            }
-            // Moon — shape based on moon_phase (0=new..4=full..7=waning)
-            int moonX = DISPLAY_WIDTH - 22, moonY = PLAY_Y + 10;
-            if (moonPh > 0) {
-                r.drawCircle(moonX, moonY, 5, COLOR_WHITE, true);
-                if (moonPh < 4) {
-                    // Waxing — shadow on left
-                    int off = (4 - moonPh) * 2;
-                    r.drawCircle(moonX - off, moonY, 5, skyColor, true);
-                } else if (moonPh > 4) {
-                    // Waning — shadow on right
-                    int off = (moonPh - 4) * 2;
-                    r.drawCircle(moonX + off, moonY, 5, skyColor, true);
-                }
-            }
-        } else if (!isNight && weather < 2) {
-            // Sun arc: rises at left (6am), peaks center (12pm), sets right (18pm)
-            float t = (float)(hour - 6) / 12.0f;
-            if (t < 0) t = 0; if (t > 1) t = 1;
-            int sunX = (int)(8 + t * (DISPLAY_WIDTH - 16));
-            int sunY = PLAY_Y + skyH - 6 - (int)(sin(t * M_PI) * (skyH - 12));
-            r.drawCircle(sunX, sunY, 6, COLOR_YELLOW, true);
-            r.drawCircle(sunX, sunY, 8, COLOR_ORANGE, false);
-        } else if (isDawn || isDusk) {
-            // Glow on horizon
-            int sunY = PLAY_Y + skyH - 6;
-            int sunX = isDawn ? 20 : DISPLAY_WIDTH - 20;
-            r.drawCircle(sunX, sunY, 9, COLOR_ORANGE, true);
-            r.drawCircle(sunX, sunY, 6, COLOR_YELLOW, true);
-        }
-
-        // Weather particles
-        if (weather == 2 || weather == 3) {
-            // Rain — diagonal lines scrolling down
-            for (int i = 0; i < 18; i++) {
-                uint32_t s = (uint32_t)(i * 73 + 17);
-                int rx = (int)((s * 1664525u + 1013904223u) >> 16) % DISPLAY_WIDTH;
-                int ry = PLAY_Y + (int)(anim * 80.0f + i * (PLAY_HEIGHT / 18.0f)) % PLAY_HEIGHT;
-                r.drawLine(rx, ry, rx - 1, ry + 5, 0x949F);
-            }
-        } else if (weather == 4) {
-            // Snow — drifting flakes
-            for (int i = 0; i < 10; i++) {
-                uint32_t s = (uint32_t)(i * 97 + 31);
-                int sx = (int)((s * 1664525u + 1013904223u) >> 16) % DISPLAY_WIDTH;
-                int sy = PLAY_Y + (int)(anim * 25.0f + i * (PLAY_HEIGHT / 10.0f)) % PLAY_HEIGHT;
-                r.drawPixel(sx, sy, COLOR_WHITE);
-                r.drawPixel(sx + 1, sy, COLOR_WHITE);
-            }
-        }
+        if (!self) { SkyCache::drawDirect(r, { 12, 0, 4 }, 0.0f); return; }
+        const EnvironmentCtx& e = self->_context->environment;
+        self->_sky.draw(r, { e.time_of_day, e.weather, e.moon_phase }, self->_timeAnim);
+        self->_weatherFx.drawFlash(r);
+        particlePool().drawScreen(r);
     }
 };
@@ -7,52 +7,60 @@
 struct StatEntry {
     bool        isHeader;
     const char* name;
-    const char* key;
+    StatId      key;
     const char* desc;
 };
 
-static const StatEntry STATS_TABLE[] = {
-    {true,  "Vitals",      nullptr, nullptr},
-    {false, "Health",      "health",      "Overall physical wellbeing."},
-    {false, "Fullness",    "fullness",    "How full your pet's belly is. Feed meals to maintain."},
-    {false, "Energy",      "energy",      "Available energy. Rest and sleep to restore."},
-    {true,  "",            nullptr, nullptr},
-    {true,  "Physical",    nullptr, nullptr},
-    {false, "Comfort",     "comfort",     "Physical ease with environment. Keep it clean and calm."},
-    {false, "Cleanliness", "cleanliness", "How clean your pet is. Groom regularly."},
-    {false, "Fitness",     "fitness",     "Athletic conditioning. Maintained through exercise and play."},
-    {false, "Grace",       "grace",       "Physical elegance. Develops through active movement."},
-    {false, "Appetite",    "appetite",    "Interest in food variety. A varied diet broadens palate."},
-    {true,  "",            nullptr, nullptr},
-    {true,  "Mental",      nullptr, nullptr},
-    {false, "Focus",       "focus",       "Concentration ability. Good rest and calm helps."},
-    {false, "Intelligence","intelligence","Problem-solving. Puzzles and training develop this."},
-    {false, "Curiosity",   "curiosity",   "Drive to explore. Expose your pet to new things."},
-    {true,  "",            nullptr, nullptr},
-    {true,  "Emotional",   nullptr, nullptr},
-    {false, "Playfulness", "playfulness", "Desire to play. Use toys and games to satisfy."},
-    {false, "Affection",   "affection",   "How loved your pet feels. Pet and spend time together."},
-    {false, "Fulfillment", "fulfillment", "Life satisfaction. A happy varied routine helps."},
-    {false, "Resilience",  "resilience",  "Ability to recover from stress. Stability builds this."},
-    {false, "Serenity",    "serenity",    "Inner peace. A low-stress routine maintains this."},
-    {false, "Patience",    "patience",    "Tolerance for waiting. Builds through consistent care."},
-    {true,  "",            nullptr, nullptr},
-    {true,  "Social",      nullptr, nullptr},
-    {false, "Sociability", "sociability", "Eagerness to interact. Social play keeps this high."},
-    {false, "Independence","independence","Comfort being alone. Confident pets are happily solo."},
-    {false, "Charisma",    "charisma",    "Appeal to others. Health and confidence influence this."},
-    {true,  "",            nullptr, nullptr},
-    {true,  "Character",   nullptr, nullptr},
-    {false, "Courage",     "courage",     "Boldness in new situations. Positive experiences build this."},
-    {false, "Loyalty",     "loyalty",     "Strength of attachment. Grows through consistent care."},
-    {false, "Mischief",    "mischievousness","Tendency toward trouble. High energy and boredom raise it."},
-    {false, "Dignity",     "dignity",     "How they carry themselves. Bounces back from embarrassment."},
-    {false, "Maturity",    "maturity",    "Behavioral sophistication. Grows naturally with experience."},
-    {false, "Craftiness",  "craftiness",  "Cleverness in getting what they want."},
-    {false, "Routine",     "routine",     "Comfort with familiar patterns. Consistency helps."},
+static constexpr StatEntry STATS_TABLE[] = {
+    {true,  "Vitals",      StatId::Count, nullptr},
+    {false, "Health",      statIdFromName("health"),      "Overall physical wellbeing."},
+    {false, "Fullness",    statIdFromName("fullness"),    "How full your pet's belly is. Feed meals to maintain."},
+    {false, "Energy",      statIdFromName("energy"),      "Available energy. Rest and sleep to restore."},
+    {true,  "",            StatId::Count, nullptr},
+    {true,  "Physical",    StatId::Count, nullptr},
+    {false, "Comfort",     statIdFromName("comfort"),     "Physical ease with environment. Keep it clean and calm."},
+    {false, "Cleanliness", statIdFromName("cleanliness"), "How clean your pet is. Groom regularly."},
+    {false, "Fitness",     statIdFromName("fitness"),     "Athletic conditioning. Maintained through exercise and play."},
+    {false, "Grace",       statIdFromName("grace"),       "Physical elegance. Develops through active movement."},
+    {false, "Appetite",    statIdFromName("appetite"),    "Interest in food variety. A varied diet broadens palate."},
+    {true,  "",            StatId::Count, nullptr},
+    {true,  "Mental",      StatId::Count, nullptr},
+    {false, "Focus",       statIdFromName("focus"),       "Concentration ability. Good rest and calm helps."},
+    {false, "Intelligence",statIdFromName("intelligence"),"Problem-solving. Puzzles and training develop this."},
+    {false, "Curiosity",   statIdFromName("curiosity"),   "Drive to explore. Expose your pet to new things."},
+    {true,  "",            StatId::Count, nullptr},
+    {true,  "Emotional",   StatId::Count, nullptr},
+    {false, "Playfulness", statIdFromName("playfulness"), "Desire to play. Use toys and games to satisfy."},
+    {false, "Affection",   statIdFromName("affection"),   "How loved your pet feels. Pet and spend time together."},
+    {false, "Fulfillment", statIdFromName("fulfillment"), "Life satisfaction. A happy varied routine helps."},
+    {false, "Resilience",  statIdFromName("resilience"),  "Ability to recover from stress. Stability builds this."},
+    {false, "Serenity",    statIdFromName("serenity"),    "Inner peace. A low-stress routine maintains this."},
+    {false, "Patience",    statIdFromName("patience"),    "Tolerance for waiting. Builds through consistent care."},
+    {true,  "",            StatId::Count, nullptr},
+    {true,  "Social",      StatId::Count, nullptr},
+    {false, "Sociability", statIdFromName("sociability"), "Eagerness to interact. Social play keeps this high."},
+    {false, "Independence",statIdFromName("independence"),"Comfort being alone. Confident pets are happily solo."},
+    {false, "Charisma",    statIdFromName("charisma"),    "Appeal to others. Health and confidence influence this."},
+    {true,  "",            StatId::Count, nullptr},
+    {true,  "Character",   StatId::Count, nullptr},
+    {false, "Courage",     statIdFromName("courage"),     "Boldness in new situations. Positive experiences build this."},
+    {false, "Loyalty",     statIdFromName("loyalty"),     "Strength of attachment. Grows through consistent care."},
+    {false, "Mischief",    statIdFromName("mischievousness"),"Tendency toward trouble. High energy and boredom raise it."},
+    {false, "Dignity",     statIdFromName("dignity"),     "How they carry themselves. Bounces back from embarrassment."},
+    {false, "Maturity",    statIdFromName("maturity"),    "Behavioral sophistication. Grows naturally with experience."},
+    {false, "Craftiness",  statIdFromName("craftiness"),  "Cleverness in getting what they want."},
+    {false, "Routine",     statIdFromName("routine"),     "Comfort with familiar patterns. Consistency helps."},
 };
 static const int STATS_TABLE_SIZE = sizeof(STATS_TABLE) / sizeof(STATS_TABLE[0]);
 
+// Catch a misspelt key at compile time rather than showing a blank bar
+static constexpr bool statsTableResolved(int i = 0) {
+    return i >= STATS_TABLE_SIZE
+        || ((STATS_TABLE[i].isHeader || STATS_TABLE[i].key != StatId::Count)
+            && statsTableResolved(i + 1));
+}
+static_assert(statsTableResolved(), "STATS_TABLE names an unknown stat");
+
 class StatsScene : public Scene {
 public:
     static const int ROW_H         = 18;
@@ -66,6 +74,7 @@ public:
     {}
 
     void enter() override { _selected=0; _scrollOff=0; _showDetail=false; }
+    bool diffFrames() const override { return true; }
 
     SceneResult update(float dt) override {
         if (_showDetail) {
@@ -13,6 +13,7 @@ public:
     {}
 
     void enter() override { _reset(); }
+    bool diffFrames() const override { return true; }
 
     SceneResult update(float dt) override {
         if (_state == ST_AI_THINKING) {
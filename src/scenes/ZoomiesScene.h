@@ -17,6 +17,7 @@ public:
         : Scene(ctx,r,inp), _state(ST_IDLE) {}
 
     void enter() override { _reset(); }
+    bool diffFrames() const override { return true; }
 
     SceneResult update(float dt) override {
         switch(_state) {
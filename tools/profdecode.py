@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""Decode the profiler's binary serial stream into a flame-style summary.
+
+Capture the stream with PROFILER_STREAM enabled, e.g.
+
+    pio device monitor --raw > prof.bin          # or any raw serial capture
+    python3 tools/profdecode.py prof.bin
+
+Text printed on the same port is skipped; only checksummed packets (see
+src/Profiler.h) are decoded.  Reads stdin when no file is given.
+"""
+
+import struct
+import sys
+
+
+def packets(data):
+    """Yield (type, payload) for every well-formed packet in data."""
+    i = 0
+    while True:
+        i = data.find(b"\xA5\x5A", i)
+        if i < 0 or i + 4 > len(data):
+            return
+        kind = data[i + 2]
+        body = i + 3
+        count = data[body]
+        if kind == ord("F"):
+            n = 1 + 4 + count * 4
+        elif kind == ord("N"):
+            n, j = 1, body + 1
+            for _ in range(count):
+                if j + 2 > len(data):
+                    return
+                n += 2 + data[j + 1]
+                j += 2 + data[j + 1]
+        else:
+            i += 2
+            continue
+        if body + n + 1 > len(data):
+            return
+        payload = data[body:body + n]
+        x = 0
+        for b in payload:
+            x ^= b
+        if x == data[body + n]:
+            yield chr(kind), payload
+            i = body + n + 1
+        else:
+            i += 2
+
+
+def decode(data):
+    zones = None     # [(name, parent)]
+    frames = []      # [[us per zone]]
+    for kind, p in packets(data):
+        if kind == "N":
+            zones, j = [], 1
+            for _ in range(p[0]):
+                parent, length = p[j], p[j + 1]
+                name = p[j + 2:j + 2 + length].decode("ascii", "replace")
+                zones.append((name, -1 if parent == 0xFF else parent))
+                j += 2 + length
+        elif kind == "F" and zones is not None and p[0] == len(zones):
+            frames.append(struct.unpack_from("<%dI" % p[0], p, 5))
+    return zones, frames
+
+
+def percentile(values, q):
+    s = sorted(values)
+    return s[min(len(s) - 1, int(q * (len(s) - 1) + 0.5))]
+
+
+def main():
+    data = open(sys.argv[1], "rb").read() if len(sys.argv) > 1 else sys.stdin.buffer.read()
+    zones, frames = decode(data)
+    if not frames:
+        sys.exit("no profiler frames found")
+
+    n = len(zones)
+    avg = [sum(f[z] for f in frames) / len(frames) for z in range(n)]
+    children = {z: [c for c in range(n) if zones[c][1] == z] for z in range(n)}
+    total = sum(avg[z] for z in range(n) if zones[z][1] < 0) or 1.0
+    width = 40
+
+    print("%d frames, %.0f us/frame profiled" % (len(frames), total))
+    print("%-18s %8s %8s %8s %6s" % ("zone", "avg us", "self us", "p99 us", "%"))
+
+    def show(z, depth):
+        self_us = avg[z] - sum(avg[c] for c in children[z])
+        p99 = percentile([f[z] for f in frames], 0.99)
+        bar = "#" * int(round(width * avg[z] / total))
+        print("%-18s %8.0f %8.0f %8d %5.1f%% %s" % (
+            "  " * depth + zones[z][0], avg[z], self_us, p99, 100.0 * avg[z] / total, bar))
+        for c in sorted(children[z], key=lambda c: -avg[c]):
+            show(c, depth + 1)
+
+    for z in sorted((z for z in range(n) if zones[z][1] < 0), key=lambda z: -avg[z]):
+        show(z, 0)
+
+
+if __name__ == "__main__":
+    main()